@@ -0,0 +1,57 @@
+/*
+ * AudioMixer.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_AUDIOMIXER_H_
+#define INC_AUDIOMIXER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "MusicTracker.h"
+
+/* Output Format */
+#define AUDIO_SAMPLE_RATE     22050U // TIM8 update rate (samples per second)
+#define AUDIO_BUFFER_SAMPLES  512U   // DMA ring, rendered one half at a time
+#define AUDIO_PWM_PERIOD      255U   // TIM10 carrier: 8-bit PWM at 168 MHz / 256
+
+/* Voice Definitions */
+typedef enum {
+    MIXER_VOICE_BGM = 0, // Square, BGM channel 1
+    MIXER_VOICE_BGM_2,   // Square, BGM channel 2
+    MIXER_VOICE_SFX,     // Square, SFX channel 1
+    MIXER_VOICE_NOISE,   // LFSR noise (SFX channel 2), the note sets the shift clock
+    MIXER_VOICE_COUNT
+} MixerVoice;
+
+/* Render Load (DWT cycles per half buffer) */
+typedef struct {
+    uint32_t lastCycles;
+    uint32_t peakCycles;
+    uint32_t budgetCycles; // Cycles available between two DMA callbacks
+} AudioMixer_Stats;
+
+/* Public API */
+void AudioMixer_Init(void);
+/* Plays song channel i on voice (first + i); the rest of the voiceCount voices are silenced */
+void AudioMixer_PlaySong(MixerVoice first, uint8_t voiceCount, const TrackerSong* song, uint8_t loop);
+void AudioMixer_StopVoice(MixerVoice voice);
+void AudioMixer_StopAll(void);
+uint8_t AudioMixer_IsVoiceActive(MixerVoice voice);
+void AudioMixer_SetVoiceGain(MixerVoice voice, uint16_t gain, uint16_t rampMs); // Q8, 256 = unity
+void AudioMixer_PauseVoice(MixerVoice voice, uint8_t pause, uint16_t rampMs);    // Fades out, keeps the song position
+void AudioMixer_SetVolume(uint8_t volume); // 0-100, applies immediately
+void AudioMixer_GetStats(AudioMixer_Stats* stats);
+
+/* DMA interrupt (DMA2 Stream1), called from stm32f4xx_it.c */
+void AudioMixer_DMA_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_AUDIOMIXER_H_ */
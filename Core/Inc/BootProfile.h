@@ -0,0 +1,59 @@
+/*
+ * BootProfile.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_BOOTPROFILE_H_
+#define INC_BOOTPROFILE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h" // For uint32_t, etc.
+
+/* Configuration */
+#ifndef BOOT_FAST
+#define BOOT_FAST                   1     // 0 = serial boot: each init step waits for the previous one (A/B runs)
+#endif
+#define BOOT_FIRST_FRAME_BUDGET_MS  100U  // Target from main() to the first frame on the panel
+
+/* Boot stages, in the order they normally complete. The reset handler
+   (data copy, bss clear) runs before main() and is not measured */
+typedef enum {
+    BOOT_STAGE_MAIN = 0,     // main() entered, time 0
+    BOOT_STAGE_HAL,          // HAL_Init
+    BOOT_STAGE_CLOCK,        // SystemClock_Config (PLL locked, 168 MHz)
+    BOOT_STAGE_SDRAM,        // MX_FMC_Init, the SDRAM power-up sequence and march test (serial boot only)
+    BOOT_STAGE_LCD,          // MX_LTDC_Init, panel init list queued
+    BOOT_STAGE_PERIPHERALS,  // Remaining MX_*_Init and TouchGFX
+    BOOT_STAGE_MEMORY,       // Framebuffers cleared, SDRAM benchmark (serial boot only)
+    BOOT_STAGE_RTOS,         // Application modules, tasks and queues created
+    BOOT_STAGE_GUI,          // TouchGFX HAL and touch controller up, GUI task running
+    BOOT_STAGE_PANEL,        // Panel init list sent (in the background)
+    BOOT_STAGE_FIRST_FRAME,  // First frame scanned out with the panel on
+    BOOT_STAGE_COUNT
+} BootProfile_Stage;
+
+#define BOOT_NOT_REACHED  0xFFFFFFFFU
+
+typedef struct {
+    uint32_t stageUs[BOOT_STAGE_COUNT]; // Since main(), BOOT_NOT_REACHED if not (yet) reached
+    uint32_t budgetUs;
+    uint8_t fast;                       // BOOT_FAST of the build
+} BootProfile_Report;
+
+/* Public API */
+void BootProfile_Start(void);                       // First statement of main()
+void BootProfile_Mark(BootProfile_Stage stage);     // Any context; only the first mark of a stage counts
+void BootProfile_DelayUs(uint32_t us);              // Busy wait on the cycle counter, needs no tick
+uint8_t BootProfile_IsComplete(void);               // First frame reached
+void BootProfile_GetReport(BootProfile_Report* report);
+int BootProfile_Format(const BootProfile_Report* report, char* buffer, uint32_t size); // JSON, one line
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_BOOTPROFILE_H_ */
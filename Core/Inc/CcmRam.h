@@ -0,0 +1,29 @@
+/*
+ * CcmRam.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_CCMRAM_H_
+#define INC_CCMRAM_H_
+
+/* Placement in the 64 KB core-coupled RAM (0x10000000, STM32F429XX_FLASH.ld).
+ *
+ * CCM sits on the CPU's D-bus alone: zero wait states and no contention with
+ * LTDC, DMA2D or DMA traffic on the main SRAM/SDRAM matrix. The flip side is
+ * that no bus master other than the CPU can reach it, so never place DMA
+ * buffers, DMA2D sources or anything handed to HAL_*_DMA() there.
+ *
+ *   CCM_BSS  zero-initialized data, cleared by the startup code
+ *   CCM_DATA initialized data, copied from flash by the startup code
+ *
+ * Run `python3 tools/memory_map.py <map file>` to see what landed where. */
+#if defined(__GNUC__) && !defined(SIMULATOR)
+#define CCM_BSS   __attribute__((section(".ccmbss")))
+#define CCM_DATA  __attribute__((section(".ccmram")))
+#else
+#define CCM_BSS
+#define CCM_DATA
+#endif
+
+#endif /* INC_CCMRAM_H_ */
@@ -0,0 +1,37 @@
+/*
+ * EntropyPool.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_ENTROPYPOOL_H_
+#define INC_ENTROPYPOOL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h" // For uint32_t, RNG_HandleTypeDef
+
+/* Pool Size (32-bit words, must be a power of two) */
+#define ENTROPY_POOL_SIZE 32U
+
+/* Health Counters */
+typedef struct {
+    uint32_t wordsGenerated; // Words delivered by the RNG interrupt
+    uint32_t wordsTaken;     // Words handed out by EntropyPool_Take
+    uint32_t underruns;      // Take calls that found the pool empty
+    uint32_t seedErrors;     // SEIS: abnormal sequence from the noise source
+    uint32_t clockErrors;    // CEIS: PLL48CLK too slow for the RNG
+} EntropyPool_Stats;
+
+/* Public API */
+void EntropyPool_Init(void);
+uint8_t EntropyPool_Take(uint32_t* value); // 1 = value written, 0 = pool empty
+void EntropyPool_GetStats(EntropyPool_Stats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ENTROPYPOOL_H_ */
@@ -165,6 +165,53 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Tickless idle: SysTick is stopped and the core sleeps (WFI) until the next
+   task wake-up. PowerManager masks the HAL tick and accounts the sleep time. */
+#define configUSE_TICKLESS_IDLE                  1
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void PowerManager_PreSleep(uint32_t* idleTicks);
+  void PowerManager_PostSleep(uint32_t idleTicks);
+#endif
+#define configPRE_SLEEP_PROCESSING(x)            PowerManager_PreSleep(&(x))
+#define configPOST_SLEEP_PROCESSING(x)           PowerManager_PostSleep(x)
+
+/* Run-time stats on the 1 MHz TIM2 time base (started by PowerManager_Init
+   before the scheduler). It keeps counting through tickless sleep, so the
+   idle task is charged with the time the core slept. */
+#define configGENERATE_RUN_TIME_STATS            1
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  uint32_t PowerManager_GetTimeUs(void);
+  void Profiler_TaskSwitchedIn(uint32_t taskNumber);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()         PowerManager_GetTimeUs()
+
+/* Trace recorder hooks (Trace.h), records go to the SDRAM ring */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #include "Trace.h"
+#endif
+#define traceTASK_SWITCHED_IN()                  do { Profiler_TaskSwitchedIn(pxCurrentTCB->uxTCBNumber); \
+                                                      Trace_TaskSwitchedIn(pxCurrentTCB->uxTCBNumber); } while (0)
+#if TRACE_ENABLED
+#define traceQUEUE_SEND(pxQueue)                 Trace_Event(TRACE_EVT_QUEUE_SEND, (pxQueue)->uxQueueNumber)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)        Trace_Event(TRACE_EVT_QUEUE_SEND, (pxQueue)->uxQueueNumber)
+#define traceQUEUE_RECEIVE(pxQueue)              Trace_Event(TRACE_EVT_QUEUE_RECEIVE, (pxQueue)->uxQueueNumber)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)     Trace_Event(TRACE_EVT_QUEUE_RECEIVE, (pxQueue)->uxQueueNumber)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue)  Trace_Event(TRACE_EVT_QUEUE_BLOCK, (pxQueue)->uxQueueNumber)
+#endif
+
+/* Stack and heap monitoring (MemoryMonitor.c). The stack top is recorded so
+   each task's allocated stack size is known at creation. */
+#define configCHECK_FOR_STACK_OVERFLOW           2
+#define configUSE_MALLOC_FAILED_HOOK             1
+#define configRECORD_STACK_HIGH_ADDRESS          1
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void MemoryMonitor_TaskCreated(uint32_t taskNumber, uint32_t stackBytes);
+#endif
+#define traceTASK_CREATE(pxNewTCB)               do { Trace_TaskCreated((pxNewTCB)->uxTCBNumber, (pxNewTCB)->pcTaskName); \
+                                                      MemoryMonitor_TaskCreated((pxNewTCB)->uxTCBNumber, \
+                                                          (uint32_t)((pxNewTCB)->pxEndOfStack - (pxNewTCB)->pxStack + 1) * sizeof(StackType_t)); } while (0)
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
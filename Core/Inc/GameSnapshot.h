@@ -0,0 +1,53 @@
+/*
+ * GameSnapshot.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_GAMESNAPSHOT_H_
+#define INC_GAMESNAPSHOT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h" // For uint32_t, etc.
+
+/* Board */
+#define GAMESNAPSHOT_ROWS     20U
+#define GAMESNAPSHOT_COLS     10U
+#define GAMESNAPSHOT_NO_PIECE 0xFFU  // Piece type when there is none (Tetris::NONE)
+
+/* Flags */
+#define GAMESNAPSHOT_FLAG_GAME_OVER  0x01U
+#define GAMESNAPSHOT_FLAG_PAUSED     0x02U
+#define GAMESNAPSHOT_FLAG_HOLD_USED  0x04U  // Hold already used for this piece
+#define GAMESNAPSHOT_FLAG_ON_SCREEN  0x08U  // Game screen shown (not the menu)
+
+/* One immutable view of the game, published by the GUI task after every
+   tick that changed something */
+typedef struct {
+    uint32_t sequence;                 // Publish count, 0 = nothing published yet
+    uint16_t rows[GAMESNAPSHOT_ROWS];  // Locked cells, bit x = column x; rows[0] is the top
+    uint8_t piece;                     // Falling piece type (Tetris::TetrominoType)
+    int8_t pieceX;                     // Top-left of its 4x4 shape box, may be off the board
+    int8_t pieceY;
+    uint8_t pieceRotation;
+    uint8_t nextPiece;
+    uint8_t heldPiece;
+    uint8_t flags;                     // GAMESNAPSHOT_FLAG_*
+    uint8_t level;
+    uint32_t score;
+    uint32_t lines;
+} GameSnapshot;
+
+/* Public API */
+void GameSnapshot_Publish(const GameSnapshot* snapshot); // Single writer (GUI task); never blocks
+uint32_t GameSnapshot_Read(GameSnapshot* snapshot);      // Any task; returns the sequence, never a torn copy
+int GameSnapshot_Format(const GameSnapshot* snapshot, char* buffer, uint32_t size); // JSON, one line
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_GAMESNAPSHOT_H_ */
@@ -0,0 +1,65 @@
+/*
+ * LcdCommand.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_LCDCOMMAND_H_
+#define INC_LCDCOMMAND_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+/* Configuration */
+#define LCDCMD_BUFFER_SIZE     256U  // Queued commands and parameters (bytes)
+#define LCDCMD_POLL_MAX        4U    // Shorter parameter lists are written directly, longer ones by DMA
+/* SPI5 clock while a list is sent. The default is the CubeMX 84 MHz / 16
+   = 5.25 MHz, inside the ILI9341 write cycle rating (100 ns, 10 MHz); the
+   speed-up comes from DMA batching with CS held low for a whole run.
+   LCDCMD_SPI_OVERCLOCK = 1 uses /8 = 10.5 MHz, 5 % over that rating: not
+   characterised, opt-in for bench experiments only */
+#ifndef LCDCMD_SPI_OVERCLOCK
+#define LCDCMD_SPI_OVERCLOCK   0
+#endif
+#if LCDCMD_SPI_OVERCLOCK
+#define LCDCMD_SPI_PRESCALER   SPI_BAUDRATEPRESCALER_8
+#else
+#define LCDCMD_SPI_PRESCALER   SPI_BAUDRATEPRESCALER_16
+#endif
+
+/* Command lists are plain byte arrays:
+ *   LCDCMD(0xB1, 2), 0x00, 0x1B,   command 0xB1 with 2 parameter bytes
+ *   LCDCMD_DELAY(5),               wait 5 ms (from the tick, without blocking)
+ */
+#define LCDCMD(cmd, n)         (uint8_t)(cmd), (uint8_t)(n)
+#define LCDCMD_DELAY(ms)       0x00U, 0xFFU, (uint8_t)(ms)
+
+/* Counters */
+typedef struct {
+    uint32_t commands;
+    uint32_t bytes;         // Command and parameter bytes sent
+    uint32_t dmaTransfers;  // Parameter lists longer than LCDCMD_POLL_MAX
+    uint32_t rejected;      // Submits that did not fit in the buffer
+    uint32_t initMs;        // Panel init list, from submit to the last byte
+} LcdCommand_Stats;
+
+/* Public API */
+void LcdCommand_Init(void);  // After MX_SPI5_Init; queues the ILI9341 init list and returns
+uint8_t LcdCommand_Submit(const uint8_t* list, uint16_t size);                 // Task context, 0 = no room
+uint8_t LcdCommand_Write(uint8_t cmd, const uint8_t* params, uint8_t count);   // One command
+uint8_t LcdCommand_IsBusy(void);
+void LcdCommand_Flush(void);  // Waits until everything queued is on the wire
+void LcdCommand_GetStats(LcdCommand_Stats* stats);
+
+/* Interrupt Hooks */
+void LcdCommand_Tick(void);              // HAL time base (TIM6), every ms
+void LcdCommand_DMA_IRQHandler(void);    // DMA2_Stream4_IRQHandler
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_LCDCOMMAND_H_ */
@@ -0,0 +1,65 @@
+/*
+ * MemoryMonitor.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_MEMORYMONITOR_H_
+#define INC_MEMORYMONITOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h" // For uint32_t, etc.
+
+/* Configuration */
+#define MEMORY_MAX_TASKS          10    // Tasks reported (and task numbers tracked)
+#define MEMORY_NAME_LEN           16    // = configMAX_TASK_NAME_LEN
+#define MEMORY_REPORT_PERIOD_MS   10000U // Sizing report on USART1 (with PROFILER_UART_DUMP)
+#define MEMORY_STACK_MARGIN_PCT   25U   // Suggested stack = deepest use + 25% ...
+#define MEMORY_STACK_MARGIN_MIN   128U  // ... but at least this many bytes of headroom
+#define MEMORY_STACK_ROUND        64U   // Suggestions are rounded up to this
+
+/* One Task Stack */
+typedef struct {
+    char name[MEMORY_NAME_LEN];
+    uint32_t stackBytes;     // Allocated at creation
+    uint32_t usedBytes;      // Deepest use so far (allocated - high-water mark)
+    uint32_t suggestedBytes; // usedBytes + margin, rounded
+} MemoryMonitor_Task;
+
+typedef struct {
+    /* FreeRTOS heap (heap_4) */
+    uint32_t heapSize;
+    uint32_t heapFree;
+    uint32_t heapMinEverFree;
+    uint32_t heapLargestFree;
+    uint32_t heapFreeBlocks;
+    uint16_t fragmentationPermille; // 1 - largest free block / free, 0-1000
+    uint32_t allocations;
+    uint32_t frees;
+
+    /* Task stacks, largest first */
+    uint32_t stackTotal;
+    uint32_t stackSuggestedTotal;
+    uint8_t taskCount;
+    MemoryMonitor_Task tasks[MEMORY_MAX_TASKS];
+} MemoryMonitor_Report;
+
+/* Public API */
+void MemoryMonitor_Update(void);                        // Takes a new sample (ProfilerTask, every window)
+void MemoryMonitor_GetReport(MemoryMonitor_Report* report); // Latest sample
+void MemoryMonitor_Sample(MemoryMonitor_Report* report);
+int MemoryMonitor_Format(const MemoryMonitor_Report* report, char* buffer, uint32_t size); // JSON, one line
+
+/* FreeRTOS hooks */
+void MemoryMonitor_TaskCreated(uint32_t taskNumber, uint32_t stackBytes); // traceTASK_CREATE
+void MemoryMonitor_StackOverflow(const char* taskName); // Logs, then halts
+void MemoryMonitor_MallocFailed(void);                  // Logs, then halts
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MEMORYMONITOR_H_ */
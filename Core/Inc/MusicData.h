@@ -0,0 +1,25 @@
+/*
+ * MusicData.h
+ *
+ * Generated by tools/music_convert.py from tools/music - do not edit
+ */
+
+#ifndef INC_MUSICDATA_H_
+#define INC_MUSICDATA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "MusicTracker.h"
+
+extern const TrackerSong song_game;
+extern const TrackerSong song_gameover;
+extern const TrackerSong song_clear;
+extern const TrackerSong song_menu;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MUSICDATA_H_ */
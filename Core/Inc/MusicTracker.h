@@ -0,0 +1,69 @@
+/*
+ * MusicTracker.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_MUSICTRACKER_H_
+#define INC_MUSICTRACKER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h" // For uint8_t, etc.
+
+/* Song Format
+ * Songs are produced by tools/music_convert.py. All channels of a song share
+ * one pool of patterns; each channel plays its own order list.
+ *
+ * Order list bytes:
+ *   0x00-0xFD  index into the pattern pool
+ *   0xFE       loop point (looping songs restart here, default: first entry)
+ *   0xFF       end of order list
+ *
+ * Pattern bytes (rows):
+ *   0x00       rest for the current length
+ *   0x01-0x60  note, 1 = C1 ... 96 = B8, for the current length
+ *   0x80-0xBF  set current length to (byte & 0x3F) + 1 ticks
+ *   0xFF       end of pattern
+ */
+#define TRACKER_MAX_CHANNELS  2
+#define TRACKER_NOTE_COUNT    96
+
+#define TRACKER_ORDER_LOOP    0xFEU
+#define TRACKER_ORDER_END     0xFFU
+#define TRACKER_ROW_REST      0x00U
+#define TRACKER_ROW_LENGTH    0x80U
+#define TRACKER_ROW_END       0xFFU
+
+/* Song Definition */
+typedef struct {
+    uint16_t tickMs;
+    uint8_t channelCount;
+    const uint8_t* const* patterns;
+    const uint8_t* order[TRACKER_MAX_CHANNELS];
+} TrackerSong;
+
+/* Decoder State (one per playing channel) */
+typedef struct {
+    const TrackerSong* song;
+    const uint8_t* order;     // Next order list entry
+    const uint8_t* loopPoint; // Where a looping channel restarts
+    const uint8_t* row;       // Next row, NULL = fetch next pattern
+    uint8_t length;           // Current row length in ticks
+    uint8_t loop;
+} TrackerChannel;
+
+/* Note Frequencies (Hz, Q8), index 0 unused (rest) */
+extern const uint32_t Tracker_NoteFreqQ8[TRACKER_NOTE_COUNT + 1];
+
+/* Public API */
+void Tracker_Start(TrackerChannel* ch, const TrackerSong* song, uint8_t channel, uint8_t loop);
+uint8_t Tracker_NextRow(TrackerChannel* ch, uint8_t* note, uint8_t* ticks); // 0 = channel finished
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MUSICTRACKER_H_ */
@@ -0,0 +1,52 @@
+/*
+ * PowerManager.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_POWERMANAGER_H_
+#define INC_POWERMANAGER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h" // For uint32_t, MCU_ACTIVE_Pin
+
+/* Render Pacing */
+#define POWER_IDLE_TIMEOUT_MS     10000U // Menu without input for this long -> low render rate
+#define POWER_IDLE_FRAME_INTERVAL 4U     // VSYNCs per rendered frame at low rate (60 Hz / 4 = 15 Hz)
+
+/* What the GUI is currently showing */
+typedef enum {
+    POWER_ACTIVITY_MENU = 0, // Full rate until POWER_IDLE_TIMEOUT_MS without input
+    POWER_ACTIVITY_PLAYING,  // Always full rate (game timing is frame based)
+    POWER_ACTIVITY_HALTED    // Paused or game over: low rate
+} PowerActivity;
+
+/* Sleep Accounting (TIM2, 1 us resolution) */
+typedef struct {
+    uint64_t sleepUs;         // Time spent in WFI from tickless idle
+    uint64_t totalUs;         // Time since PowerManager_Init
+    uint32_t sleeps;          // Tickless sleeps entered
+    uint32_t framesThrottled; // VSYNCs skipped by the low render rate
+} PowerManager_Stats;
+
+/* Public API */
+void PowerManager_Init(void);
+void PowerManager_NotifyInput(void);                  // Any context
+void PowerManager_SetActivity(PowerActivity activity);
+uint8_t PowerManager_GetFrameInterval(void);          // 1 = render every VSYNC
+void PowerManager_FrameThrottled(void);
+void PowerManager_GetStats(PowerManager_Stats* stats);
+uint32_t PowerManager_GetTimeUs(void);                // TIM2, wraps after ~71 min
+
+/* Tickless idle hooks (configPRE/POST_SLEEP_PROCESSING), interrupts disabled */
+void PowerManager_PreSleep(uint32_t* idleTicks);
+void PowerManager_PostSleep(uint32_t idleTicks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_POWERMANAGER_H_ */
@@ -0,0 +1,55 @@
+/*
+ * Profiler.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_PROFILER_H_
+#define INC_PROFILER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h" // For uint32_t, etc.
+
+/* Configuration */
+#define PROFILER_PERIOD_MS   1000U // Sample window
+#define PROFILER_MAX_TASKS   10    // Tasks reported (and task numbers tracked)
+#define PROFILER_NAME_LEN    16    // = configMAX_TASK_NAME_LEN
+#ifndef PROFILER_UART_DUMP
+#define PROFILER_UART_DUMP   1     // 1 = one JSON line per window on USART1
+#endif
+
+/* One Task, over the last sample window */
+typedef struct {
+    char name[PROFILER_NAME_LEN];
+    uint32_t runTimeUs;      // Time the task was running
+    uint16_t cpuPermille;    // runTimeUs / window, 0-1000
+    uint8_t priority;
+    uint8_t state;           // eTaskState
+    uint32_t stackFreeBytes; // High-water mark since the task started
+    uint32_t switches;       // Times the scheduler switched to the task
+} Profiler_TaskInfo;
+
+typedef struct {
+    uint32_t sequence;       // Incremented per window, 0 = no sample yet
+    uint32_t windowUs;
+    uint32_t switches;       // All context switches in the window
+    uint8_t taskCount;
+    Profiler_TaskInfo tasks[PROFILER_MAX_TASKS]; // Sorted by CPU, highest first
+} Profiler_Report;
+
+/* Public API */
+void ProfilerTask(void *argument);
+uint32_t Profiler_GetReport(Profiler_Report* report); // Returns report->sequence
+int Profiler_Format(const Profiler_Report* report, char* buffer, uint32_t size); // JSON, one line
+
+/* traceTASK_SWITCHED_IN hook, runs inside the scheduler */
+void Profiler_TaskSwitchedIn(uint32_t taskNumber);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_PROFILER_H_ */
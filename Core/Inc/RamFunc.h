@@ -0,0 +1,61 @@
+/*
+ * RamFunc.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_RAMFUNC_H_
+#define INC_RAMFUNC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Only stdint: also included by the TouchGFX model (and the simulator) */
+#include <stdint.h>
+
+/* Configuration */
+#ifndef RAMFUNC_ENABLED
+#define RAMFUNC_ENABLED      1   // 0 = hot functions stay in flash (for A/B runs)
+#endif
+#define RAMFUNC_BENCHMARK    1   // Flash vs RAM cycle counts once at boot, on USART1
+#define RAMFUNC_BENCH_RUNS   64  // Calls averaged per measurement
+#define RAMFUNC_BENCH_KERNELS 2
+
+/* Hot code executed from SRAM: functions marked RAM_FUNC go to the .RamFunc
+ * input section, which STM32F429XX_FLASH.ld keeps in .data so the startup
+ * code copies it from flash with the initialized data. Flash needs 5 wait
+ * states at 168 MHz and only the ART cache hides them; code in SRAM takes
+ * the same number of cycles whether or not it was just run. Marked functions
+ * are never inlined into flash callers; calls between flash and SRAM go
+ * through linker veneers (a few cycles each way). */
+#if RAMFUNC_ENABLED && defined(__GNUC__) && !defined(SIMULATOR)
+#define RAM_FUNC  __attribute__((section(".RamFunc"), noinline))
+#else
+#define RAM_FUNC
+#endif
+
+/* Benchmark: average cycles per call of the same kernel in each place;
+   "cold" flushes the ART instruction/data caches before every call */
+typedef struct {
+    const char* name;
+    uint32_t flashCycles;
+    uint32_t flashColdCycles;
+    uint32_t ramCycles;
+    uint32_t ramColdCycles;
+} RamFunc_Result;
+
+typedef struct {
+    uint8_t count;
+    RamFunc_Result results[RAMFUNC_BENCH_KERNELS];
+} RamFunc_Report;
+
+/* Public API */
+void RamFunc_Benchmark(RamFunc_Report* report); // Task context, interrupts masked around each timed call
+int RamFunc_Format(const RamFunc_Report* report, char* buffer, uint32_t size); // JSON, one line
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_RAMFUNC_H_ */
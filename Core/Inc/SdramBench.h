@@ -0,0 +1,65 @@
+/*
+ * SdramBench.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_SDRAMBENCH_H_
+#define INC_SDRAMBENCH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h" // For uint32_t, etc.
+#include "BootProfile.h"
+
+/* Configuration */
+#ifndef SDRAMBENCH_AT_BOOT
+#define SDRAMBENCH_AT_BOOT   (!BOOT_FAST)  // Run once before the scheduler (~0.5 s), serial boot only
+#endif
+#define SDRAMBENCH_WIDTH     240U          // Test image = one screen
+#define SDRAMBENCH_HEIGHT    320U
+#define SDRAMBENCH_RUNS      4U            // Averaged per measurement
+
+/* One access pattern; all rates are MB/s of pixels written (or read, for
+   the CPU read patterns) */
+typedef enum {
+    SDRAMBENCH_CPU_READ = 0,     // 32-bit words, ascending
+    SDRAMBENCH_CPU_WRITE,
+    SDRAMBENCH_CPU_COLUMN_READ,  // One word per ARGB8888 line: new SDRAM row on every access
+    SDRAMBENCH_CPU_COLUMN_WRITE,
+    SDRAMBENCH_FILL_RGB565,      // DMA2D register to memory
+    SDRAMBENCH_COPY_RGB565,      // DMA2D memory to memory
+    SDRAMBENCH_BLEND_RGB565,     // DMA2D blend, constant alpha, both layers in SDRAM
+    SDRAMBENCH_FILL_ARGB8888,
+    SDRAMBENCH_COPY_ARGB8888,
+    SDRAMBENCH_BLEND_ARGB8888,
+    SDRAMBENCH_COUNT
+} SdramBench_Test;
+
+typedef struct {
+    uint8_t valid;
+    uint32_t mbpsLtdcOff[SDRAMBENCH_COUNT];
+    uint32_t mbpsLtdcOn[SDRAMBENCH_COUNT];  // LTDC scanning an RGB565 framebuffer in SDRAM meanwhile
+
+    /* Bitmap atlas (TouchGFXHAL.cpp): every atlas bitmap blitted once */
+    uint8_t atlasBitmaps;                   // 0 = no atlas
+    uint32_t atlasBytes;
+    uint32_t atlasFlashCycles;              // Sources in internal flash
+    uint32_t atlasSdramCycles;              // Sources packed in the SDRAM atlas
+} SdramBench_Report;
+
+/* Public API (boot, before the scheduler: uses DMA2D and LTDC without the GUI) */
+void SdramBench_Run(void);
+uint32_t SdramBench_BlitCycles(const void* pixels, const uint32_t* clut, uint16_t clutSize,
+                               uint16_t width, uint16_t height); // ARGB8888 (clut = 0) or L8, blended onto RGB565
+void SdramBench_SetAtlas(uint8_t bitmaps, uint32_t bytes, uint32_t flashCycles, uint32_t sdramCycles);
+void SdramBench_GetReport(SdramBench_Report* report);
+int SdramBench_Format(const SdramBench_Report* report, char* buffer, uint32_t size); // JSON, one line
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_SDRAMBENCH_H_ */
@@ -0,0 +1,49 @@
+/*
+ * SdramTest.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_SDRAMTEST_H_
+#define INC_SDRAMTEST_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h" // For uint32_t, etc.
+#include "BootProfile.h"
+
+/* Configuration */
+#ifndef SDRAMTEST_MARCH
+#define SDRAMTEST_MARCH        (!BOOT_FAST)  // March test at boot (~0.5 s for 8 MB), skipped by the fast boot
+#endif
+#define SDRAMTEST_BASE         0xD0000000U
+#define SDRAMTEST_SIZE         0x00800000U   // Bytes tested, multiple of SDRAMTEST_LINE_BYTES
+#define SDRAMTEST_LINE_BYTES   8192U         // DMA2D fill line (2048 ARGB8888 pixels)
+#define SDRAMTEST_PATTERN      0xAAAA5555U   // Background; neighbouring data lines differ in both phases
+#define SDRAMTEST_CLEAR_COLOR  0x0000U       // RGB565 the framebuffers start with
+#define SDRAMTEST_FB_WIDTH     240U          // Pixels per framebuffer line
+
+typedef struct {
+    uint8_t marchRun;        // 0 = test skipped
+    uint32_t errors;         // Words that read back wrong (all elements)
+    uint32_t firstError;     // Address of the first one, 0 if none
+    uint32_t fillMBps;       // DMA2D register-to-memory fill, 32 bpp
+    uint32_t readMBps;       // CPU word reads, ascending
+    uint32_t readWriteMBps;  // CPU read then write of each word, ascending
+    uint32_t clearUs;        // Both framebuffers, DMA2D RGB565 fill
+    uint32_t clearMBps;
+} SdramTest_Report;
+
+/* Public API (boot, before the scheduler) */
+uint8_t SdramTest_March(void);          // March X over SDRAMTEST_SIZE bytes; 1 = pass. Right after the SDRAM init: destroys the contents
+void SdramTest_ClearFramebuffers(void); // Deterministic first frame; DMA2D must be clocked (MX_DMA2D_Init)
+void SdramTest_GetReport(SdramTest_Report* report);
+int SdramTest_Format(const SdramTest_Report* report, char* buffer, uint32_t size); // JSON, one line
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_SDRAMTEST_H_ */
@@ -13,13 +13,7 @@ extern "C" {
 #endif
 
 #include "main.h" // For uint16_t, etc.
-#include "cmsis_os.h" // For osMessageQueueId_t (if needed in public API, usually not)
-
-/* Note Definition */
-typedef struct {
-    uint16_t frequency; // Hz (0 = Rest)
-    uint16_t duration;  // Milliseconds
-} MusicNote;
+#include "cmsis_os.h" // For osThreadId_t (if needed in public API, usually not)
 
 /* Track Definitions */
 typedef enum {
@@ -31,11 +25,19 @@ typedef enum {
     TRACK_COUNT
 } TrackID;
 
+/* Command Channel Counters */
+typedef struct {
+    uint32_t posted;  // Requests accepted by SoundEngine_PlayTrack
+    uint32_t merged;  // Requests folded into one still pending (duplicate or newer BGM)
+    uint32_t dropped; // Invalid, or outranked by a higher-priority SFX
+} SoundEngine_Stats;
+
 /* Public API */
 void SoundEngine_Init(void);
-void SoundEngine_PlayTrack(TrackID track);
+void SoundEngine_PlayTrack(TrackID track); // Non-blocking, safe from any task or ISR
 void SoundEngine_Stop(void);
 void SoundEngine_SetVolume(uint8_t volume);
+void SoundEngine_GetStats(SoundEngine_Stats* stats);
 
 /* Task Function (Exposed for FreeRTOS creation) */
 void SoundEngineTask(void *argument);
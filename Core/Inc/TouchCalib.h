@@ -0,0 +1,71 @@
+/*
+ * TouchCalib.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_TOUCHCALIB_H_
+#define INC_TOUCHCALIB_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h" // For uint32_t, FLASH_SECTOR_23
+
+/* Filter Defaults (TouchCalib_SetFilter changes them at run time) */
+#define TOUCHCAL_MEDIAN_TAPS     3U    // 1 (off), 3 or 5 raw samples
+#define TOUCHCAL_IIR_SHIFT       1U    // Low pass weight 1/2^shift, 0 = off
+#define TOUCHCAL_DEADBAND_PX     2U    // Output only moves by more than this (x + y)
+
+/* Calibration */
+#define TOUCHCAL_POINTS          3U
+#define TOUCHCAL_SETTLE_SAMPLES  2U    // Ignored after pen down, while the panel settles
+#define TOUCHCAL_MIN_SAMPLES     4U    // Averaged per target, else the tap is repeated
+
+/* Storage: last 128 KB sector, kept out of the image by STM32F429XX_FLASH.ld.
+   Records are appended; the sector is only erased once it is full */
+#define TOUCHCAL_FLASH_SECTOR    FLASH_SECTOR_23
+#define TOUCHCAL_FLASH_ADDR      0x081E0000U
+#define TOUCHCAL_FLASH_SIZE      0x20000U
+
+/* Raw 12-bit sample -> screen: x = (a*rx + b*ry + c) >> 16, y = (d*rx + e*ry + f) >> 16 */
+typedef struct {
+    int32_t a, b, c;
+    int32_t d, e, f;
+} TouchCalib_Transform;
+
+typedef struct {
+    uint8_t medianTaps;
+    uint8_t iirShift;
+    uint8_t deadbandPx;
+} TouchCalib_Filter;
+
+typedef enum {
+    TOUCHCAL_IDLE = 0,
+    TOUCHCAL_RUNNING,  // Waiting for a tap on target TouchCalib_GetStep()
+    TOUCHCAL_SAVED,    // New transform in use and stored
+    TOUCHCAL_UNSAVED,  // New transform in use until reset; the flash write failed
+    TOUCHCAL_FAILED    // Taps did not give a usable transform; the old one is kept
+} TouchCalib_State;
+
+/* Public API (GUI task) */
+void TouchCalib_Init(uint8_t isRevD, uint16_t width, uint16_t height); // Stored transform, else the board default
+void TouchCalib_SetFilter(const TouchCalib_Filter* filter);
+void TouchCalib_Reset(void);                                           // Pen up: forget the filter history
+void TouchCalib_Process(uint16_t rawX, uint16_t rawY, uint16_t* x, uint16_t* y);
+void TouchCalib_GetTransform(TouchCalib_Transform* transform);
+
+/* 3-Point Calibration: while running, raw samples go to Capture instead of Process */
+void TouchCalib_Start(void);
+TouchCalib_State TouchCalib_GetState(void);
+uint8_t TouchCalib_GetStep(void);
+void TouchCalib_GetTarget(uint8_t step, uint16_t* x, uint16_t* y);
+void TouchCalib_CaptureSample(uint16_t rawX, uint16_t rawY);
+void TouchCalib_CaptureRelease(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TOUCHCALIB_H_ */
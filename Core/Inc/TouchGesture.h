@@ -0,0 +1,44 @@
+/*
+ * TouchGesture.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_TOUCHGESTURE_H_
+#define INC_TOUCHGESTURE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Configuration (screen pixels and milliseconds) */
+#define GESTURE_CELL_PX          12U   // Drag distance per move/soft drop (one matrix cell)
+#define GESTURE_SLOP_PX          6U    // Movement below this is still a tap
+#define GESTURE_TAP_MAX_MS       250U  // Longer presses are not taps
+#define GESTURE_HARD_DROP_PX_S   900U  // Downward release speed for a hard drop
+#define GESTURE_MAX_MOVES        2U    // Most keys queued per GUI tick, over all its samples (inputQueue sizing)
+
+/* Counters for the debug output */
+typedef struct {
+    uint32_t taps;
+    uint32_t moves;
+    uint32_t softDrops;
+    uint32_t hardDrops;
+    uint32_t lost;       // Keys not queued (inputQueue full despite the per-tick cap)
+} TouchGesture_Stats;
+
+/* Public API (GUI task only) */
+void TouchGesture_Enable(int16_t x, int16_t y, int16_t width, int16_t height); // Gestures must start in this area
+void TouchGesture_Disable(void);
+void TouchGesture_BeginTick(void);                               // Once per sampleTouch, before its samples
+void TouchGesture_Sample(int16_t x, int16_t y, uint32_t timeMs); // Every touch sample, in screen coordinates
+void TouchGesture_Release(uint32_t timeMs);                      // Pen up
+void TouchGesture_GetStats(TouchGesture_Stats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TOUCHGESTURE_H_ */
@@ -0,0 +1,55 @@
+/*
+ * TouchSampler.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_TOUCHSAMPLER_H_
+#define INC_TOUCHSAMPLER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h" // For uint32_t, I2C_HandleTypeDef
+
+/* Configuration */
+#define TOUCH_I2C_ADDRESS      0x82  // STMPE811 on I2C3
+#define TOUCH_FIFO_THRESHOLD   4U    // Samples per FIFO_TH interrupt
+#define TOUCH_BURST_SAMPLES    16U   // Most samples fetched per DMA burst
+#define TOUCH_RING_SIZE        32U   // Samples buffered for the GUI task (power of two)
+#define TOUCH_STUCK_MS         20U   // A transfer older than this is reset by TouchSampler_Poll
+
+/* One Raw Sample (12-bit ADC values, see STM32TouchController.cpp for the screen mapping) */
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint8_t z;        // Pressure
+    uint32_t timeMs;  // HAL tick when the burst was read
+} TouchSampler_Sample;
+
+/* Health Counters */
+typedef struct {
+    uint32_t interrupts;  // STMPE811 INT edges (PA15)
+    uint32_t bursts;      // FIFO reads by DMA
+    uint32_t samples;     // Samples read from the FIFO
+    uint32_t dropped;     // Samples lost: ring full or FIFO overflow
+    uint32_t errors;      // I2C errors and stuck transfers
+} TouchSampler_Stats;
+
+/* Public API */
+void TouchSampler_Init(void);  // After BSP_TS_Init; from here on I2C3 belongs to the sampler
+uint8_t TouchSampler_Read(TouchSampler_Sample* sample); // Oldest unread sample, 0 = none
+uint8_t TouchSampler_IsTouched(void);
+void TouchSampler_Poll(void);  // GUI task, every tick: recovers missed edges and stuck transfers
+void TouchSampler_GetStats(TouchSampler_Stats* stats);
+
+/* Interrupt Hooks */
+void TouchSampler_EXTI_Callback(void);     // HAL_GPIO_EXTI_Callback, GPIO_PIN_15
+void TouchSampler_DMA_IRQHandler(void);    // DMA1_Stream2_IRQHandler
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TOUCHSAMPLER_H_ */
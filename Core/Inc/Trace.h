@@ -0,0 +1,92 @@
+/*
+ * Trace.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INC_TRACE_H_
+#define INC_TRACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Only stdint: this header is also pulled in by FreeRTOSConfig.h */
+#include <stdint.h>
+
+/* Configuration */
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED        1       // 0 = all trace hooks compile to nothing
+#endif
+#define TRACE_RECORD_COUNT   65536U  // Power of two, 12 bytes each (768 KB of SDRAM)
+#define TRACE_MAX_TASKS      16      // Task names kept, indexed by FreeRTOS task number
+#define TRACE_MAX_QUEUES     8       // Queue names kept, indexed by queue number
+#define TRACE_NAME_LEN       16
+#define TRACE_MAGIC          0x45435254U // "TRCE"
+#define TRACE_VERSION        1U
+
+/* Event IDs (tools/trace_decode.py keeps the same table) */
+#define TRACE_EVT_TASK_SWITCH    0x01U // context = task switched in
+#define TRACE_EVT_QUEUE_SEND     0x02U // arg = queue number
+#define TRACE_EVT_QUEUE_RECEIVE  0x03U // arg = queue number
+#define TRACE_EVT_QUEUE_BLOCK    0x04U // arg = queue number, task blocks on receive
+#define TRACE_EVT_ISR_ENTER      0x05U // arg = exception number (IRQn + 16)
+#define TRACE_EVT_ISR_EXIT       0x06U // arg = exception number
+#define TRACE_EVT_SLEEP          0x07U // arg = us in WFI, the cycle counter stood still
+#define TRACE_EVT_STACK_OVERFLOW 0x08U // Last record before the halt
+#define TRACE_EVT_MALLOC_FAILED  0x09U // Last record before the halt
+#define TRACE_EVT_GAME_TICK      0x20U // arg = frames rendered so far
+#define TRACE_EVT_PIECE_LOCK     0x21U // arg = TetrominoType
+#define TRACE_EVT_LINE_CLEAR     0x22U // arg = lines cleared at once
+#define TRACE_EVT_RENDER_START   0x23U
+#define TRACE_EVT_RENDER_END     0x24U
+
+#define TRACE_CONTEXT_ISR        0x8000U // context = TRACE_CONTEXT_ISR | exception number
+
+/* One Event */
+typedef struct {
+    uint32_t cycles;   // DWT->CYCCNT, wraps every ~25 s at 168 MHz
+    uint16_t event;
+    uint16_t context;  // Task number, or TRACE_CONTEXT_ISR | exception number
+    uint32_t arg;
+} TraceRecord;
+
+/* SDRAM Ring
+ * Dump sizeof(TraceBuffer) bytes from &traceBuffer and feed them to
+ * tools/trace_decode.py; everything needed to decode is in the header. */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t cpuHz;
+    uint32_t recordCount;
+    volatile uint32_t head; // Records written since Trace_Init, newest = head - 1
+    char taskNames[TRACE_MAX_TASKS][TRACE_NAME_LEN];
+    char queueNames[TRACE_MAX_QUEUES][TRACE_NAME_LEN];
+    TraceRecord records[TRACE_RECORD_COUNT];
+} TraceBuffer;
+
+extern TraceBuffer traceBuffer;
+
+/* Public API */
+void Trace_Init(void); // After SDRAM init, before the scheduler starts
+void Trace_Event(uint16_t event, uint32_t arg); // Any context, interrupts briefly masked
+void Trace_TaskSwitchedIn(uint32_t taskNumber);
+void Trace_TaskCreated(uint32_t taskNumber, const char* name);
+void Trace_NameQueue(void* queue, const char* name);
+
+/* Hooks, empty when tracing is compiled out (or in the TouchGFX simulator) */
+#if TRACE_ENABLED && !defined(SIMULATOR)
+#define TRACE_EVENT(event, arg)  Trace_Event((event), (uint32_t)(arg))
+#define TRACE_ISR_ENTER()        Trace_Event(TRACE_EVT_ISR_ENTER, __get_IPSR())
+#define TRACE_ISR_EXIT()         Trace_Event(TRACE_EVT_ISR_EXIT, __get_IPSR())
+#else
+#define TRACE_EVENT(event, arg)
+#define TRACE_ISR_ENTER()
+#define TRACE_ISR_EXIT()
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TRACE_H_ */
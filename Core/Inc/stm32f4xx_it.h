@@ -60,6 +60,13 @@ void TIM6_DAC_IRQHandler(void);
 void LTDC_IRQHandler(void);
 void DMA2D_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void HASH_RNG_IRQHandler(void);
+void DMA2_Stream1_IRQHandler(void);
+void DMA1_Stream2_IRQHandler(void);
+void DMA2_Stream4_IRQHandler(void);
+void I2C3_EV_IRQHandler(void);
+void I2C3_ER_IRQHandler(void);
+void USART1_IRQHandler(void);
 
 /* USER CODE END EFP */
 
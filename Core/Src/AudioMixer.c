@@ -0,0 +1,405 @@
+/*
+ * AudioMixer.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "AudioMixer.h"
+#include "stm32f4xx_hal.h"
+#include "CcmRam.h"
+#include "RamFunc.h"
+
+/* External PWM Timer Handle */
+extern TIM_HandleTypeDef htim10;
+
+#define HALF_SAMPLES   (AUDIO_BUFFER_SAMPLES / 2)
+#define HALF_PAIRS     (HALF_SAMPLES / 2)
+#define VOICE_MAX_AMP  (32767 / MIXER_VOICE_COUNT) // Full-scale sum never clips
+#define PWM_MIDPOINT   ((AUDIO_PWM_PERIOD + 1) / 2)
+#define NOISE_TAPS     0xB400U                     // 16-bit Galois LFSR, maximal length
+#define GAIN_UNITY     256U                        // Voice gain, Q8
+#define RAMP_CHUNK     16U                         // Gain steps every 16 pairs (~1.5 ms) while ramping
+
+/* Oscillator + song channel state of one voice */
+typedef struct {
+    uint32_t phase;          // Q32 phase accumulator
+    uint32_t phaseInc;       // 0 = rest
+    uint32_t lfsr;           // Noise voices only
+    uint8_t  isNoise;
+
+    TrackerChannel player;   // player.song == NULL = idle
+    uint32_t pairsPerTick;
+    uint32_t pairsLeft;      // Sample pairs left in the current row
+
+    uint16_t gain;           // Current gain (Q8)
+    uint16_t level;          // Gain to ramp towards while not paused
+    uint16_t gainStep;       // Gain change per ramp chunk
+    uint8_t  paused;         // Fade to 0, then freeze the song position
+} Voice;
+
+/* Internal State */
+/* The DMA ring must stay in main SRAM; everything the mixer interrupt only
+   touches with the CPU lives in CCM */
+static TIM_HandleTypeDef htim8;        // Sample clock
+static DMA_HandleTypeDef hdma_audio;   // TIM8_UP -> TIM10->CCR1 (DMA2 Stream1 Ch7)
+static uint16_t dmaBuffer[AUDIO_BUFFER_SAMPLES] __attribute__((aligned(4)));
+static uint32_t mixBuffer[HALF_PAIRS] CCM_BSS; // Two packed int16 samples per word
+static Voice voices[MIXER_VOICE_COUNT] CCM_BSS;
+static uint32_t notePhaseInc[TRACKER_NOTE_COUNT + 1] CCM_BSS;
+static volatile int32_t voiceAmp CCM_DATA = VOICE_MAX_AMP / 2;
+static volatile AudioMixer_Stats stats;
+
+/* Helper: Keep the render interrupt out while the task edits voices */
+static void Mixer_Lock(void)
+{
+    HAL_NVIC_DisableIRQ(DMA2_Stream1_IRQn);
+}
+
+static void Mixer_Unlock(void)
+{
+    HAL_NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+}
+
+/* Helper: Decode the voice's next row (returns 0 once a one-shot song ends) */
+static uint8_t Voice_NextNote(Voice* v)
+{
+    uint8_t note, ticks;
+
+    if (!Tracker_NextRow(&v->player, &note, &ticks))
+    {
+        v->phaseInc = 0;
+        return 0;
+    }
+
+    /* Phase is kept across rows, so tied rows and note changes don't click */
+    v->phaseInc = notePhaseInc[note];
+    v->pairsLeft = ticks * v->pairsPerTick;
+    return 1;
+}
+
+/* Helper: Add n sample pairs of a 50% square wave into mix */
+static RAM_FUNC void Voice_RenderSquare(Voice* v, uint32_t* mix, uint32_t n, int32_t amp)
+{
+    uint32_t phase = v->phase;
+    uint32_t inc = v->phaseInc;
+
+    while (n--)
+    {
+        int32_t s0, s1;
+        phase += inc; s0 = ((int32_t)phase < 0) ? -amp : amp;
+        phase += inc; s1 = ((int32_t)phase < 0) ? -amp : amp;
+        /* Pack both samples and add with 16-bit saturation in one instruction */
+        *mix = __QADD16(*mix, __PKHBT(s0, s1, 16));
+        mix++;
+    }
+    v->phase = phase;
+}
+
+/* Helper: Add n sample pairs of LFSR noise into mix; the LFSR shifts on phase wrap */
+static RAM_FUNC void Voice_RenderNoise(Voice* v, uint32_t* mix, uint32_t n, int32_t amp)
+{
+    uint32_t phase = v->phase;
+    uint32_t inc = v->phaseInc;
+    uint32_t lfsr = v->lfsr;
+
+    while (n--)
+    {
+        int32_t s0, s1;
+        phase += inc;
+        if (phase < inc) lfsr = (lfsr >> 1) ^ (-(lfsr & 1U) & NOISE_TAPS);
+        s0 = (lfsr & 1U) ? amp : -amp;
+        phase += inc;
+        if (phase < inc) lfsr = (lfsr >> 1) ^ (-(lfsr & 1U) & NOISE_TAPS);
+        s1 = (lfsr & 1U) ? amp : -amp;
+        *mix = __QADD16(*mix, __PKHBT(s0, s1, 16));
+        mix++;
+    }
+    v->phase = phase;
+    v->lfsr = lfsr;
+}
+
+/* Helper: Render one voice for a block, splitting it at note boundaries */
+static RAM_FUNC void Voice_Render(Voice* v, uint32_t* mix, uint32_t pairs, int32_t amp)
+{
+    while (pairs > 0 && v->player.song != NULL)
+    {
+        uint32_t n;
+
+        if (v->pairsLeft == 0 && !Voice_NextNote(v))
+        {
+            break;
+        }
+
+        n = (v->pairsLeft < pairs) ? v->pairsLeft : pairs;
+        if (v->phaseInc != 0)
+        {
+            if (v->isNoise) Voice_RenderNoise(v, mix, n, amp);
+            else            Voice_RenderSquare(v, mix, n, amp);
+        }
+        v->pairsLeft -= n;
+        pairs -= n;
+        mix += n;
+    }
+}
+
+/* Helper: Render one voice for a whole half buffer, applying its gain ramp */
+static RAM_FUNC void Voice_Mix(Voice* v, uint32_t* mix, int32_t amp)
+{
+    uint32_t target = v->paused ? 0 : v->level;
+    uint32_t done = 0;
+
+    while (done < HALF_PAIRS)
+    {
+        uint32_t n = HALF_PAIRS - done;
+
+        if (v->gain != target)
+        {
+            /* Linear ramp, one step per chunk so changes don't click */
+            if (v->gain < target)
+                v->gain = (target - v->gain > v->gainStep) ? v->gain + v->gainStep : target;
+            else
+                v->gain = (v->gain - target > v->gainStep) ? v->gain - v->gainStep : target;
+            n = RAMP_CHUNK;
+        }
+
+        if (v->paused && v->gain == 0)
+        {
+            return; // Frozen: the song resumes from here
+        }
+
+        Voice_Render(v, mix + done, n, (amp * v->gain) >> 8);
+        done += n;
+    }
+}
+
+/* Helper: Gain step that covers full scale in rampMs */
+static uint16_t Ramp_Step(uint16_t rampMs)
+{
+    uint32_t chunks = ((uint32_t)rampMs * AUDIO_SAMPLE_RATE) / (2000U * RAMP_CHUNK);
+
+    if (chunks == 0) return GAIN_UNITY;
+    return (chunks >= GAIN_UNITY) ? 1 : (uint16_t)(GAIN_UNITY / chunks);
+}
+
+/* Helper: Fill one half of the DMA ring (interrupt context, runs from SRAM
+   with the voice renderers; stats.lastCycles shows the effect of RAMFUNC_ENABLED) */
+static RAM_FUNC void Mixer_RenderHalf(uint16_t* out)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t* out32 = (uint32_t*)out;
+    int32_t amp = voiceAmp;
+    uint8_t active = 0;
+    uint32_t k;
+
+    for (k = 0; k < MIXER_VOICE_COUNT; k++)
+    {
+        if (voices[k].player.song != NULL) active = 1;
+    }
+
+    if (!active)
+    {
+        /* Idle: hold the carrier at its midpoint */
+        for (k = 0; k < HALF_PAIRS; k++) out32[k] = (PWM_MIDPOINT << 16) | PWM_MIDPOINT;
+    }
+    else
+    {
+        for (k = 0; k < HALF_PAIRS; k++) mixBuffer[k] = 0;
+
+        for (k = 0; k < MIXER_VOICE_COUNT; k++)
+        {
+            if (voices[k].player.song != NULL) Voice_Mix(&voices[k], mixBuffer, amp);
+        }
+
+        /* Signed 16-bit pairs -> offset-binary 8-bit compare values, two per word */
+        for (k = 0; k < HALF_PAIRS; k++)
+        {
+            out32[k] = ((mixBuffer[k] ^ 0x80008000U) >> 8) & 0x00FF00FFU;
+        }
+    }
+
+    stats.lastCycles = DWT->CYCCNT - start;
+    if (stats.lastCycles > stats.peakCycles) stats.peakCycles = stats.lastCycles;
+}
+
+/* DMA Callbacks: the other half is being played out, refill this one */
+static RAM_FUNC void Mixer_HalfCallback(DMA_HandleTypeDef* hdma)
+{
+    (void)hdma;
+    Mixer_RenderHalf(&dmaBuffer[0]);
+}
+
+static RAM_FUNC void Mixer_FullCallback(DMA_HandleTypeDef* hdma)
+{
+    (void)hdma;
+    Mixer_RenderHalf(&dmaBuffer[HALF_SAMPLES]);
+}
+
+/* API Implementation */
+
+void AudioMixer_Init(void)
+{
+    uint32_t timerClock = 2 * HAL_RCC_GetPCLK2Freq(); // APB2 Timer Clock = 168 MHz
+    uint32_t k;
+
+    __HAL_RCC_TIM8_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    /* Cycle counter for the render load figures */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    stats.budgetCycles = SystemCoreClock / AUDIO_SAMPLE_RATE * HALF_SAMPLES;
+
+    for (k = 0; k < MIXER_VOICE_COUNT; k++)
+    {
+        voices[k].lfsr = 1;
+        voices[k].gain = GAIN_UNITY;
+        voices[k].level = GAIN_UNITY;
+        voices[k].gainStep = GAIN_UNITY;
+    }
+    for (k = 0; k <= TRACKER_NOTE_COUNT; k++)
+    {
+        /* Hz (Q8) -> Q32 phase step per sample */
+        notePhaseInc[k] = (uint32_t)(((uint64_t)Tracker_NoteFreqQ8[k] << 24) / AUDIO_SAMPLE_RATE);
+    }
+    voices[MIXER_VOICE_NOISE].isNoise = 1;
+
+    for (k = 0; k < AUDIO_BUFFER_SAMPLES; k++)
+    {
+        dmaBuffer[k] = PWM_MIDPOINT;
+    }
+
+    /* TIM10 becomes the PWM carrier (prescaler 0, 8-bit period -> ~656 kHz).
+       ARR/CCR1 preload so DMA writes land on a carrier period boundary. */
+    __HAL_TIM_SET_PRESCALER(&htim10, 0);
+    __HAL_TIM_SET_AUTORELOAD(&htim10, AUDIO_PWM_PERIOD);
+    __HAL_TIM_SET_COMPARE(&htim10, TIM_CHANNEL_1, PWM_MIDPOINT);
+    SET_BIT(htim10.Instance->CR1, TIM_CR1_ARPE);
+    htim10.Instance->EGR = TIM_EGR_UG;
+    HAL_TIM_PWM_Start(&htim10, TIM_CHANNEL_1);
+
+    /* TIM8: one update (= one DMA request) per sample */
+    htim8.Instance = TIM8;
+    htim8.Init.Prescaler = 0;
+    htim8.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim8.Init.Period = (timerClock / AUDIO_SAMPLE_RATE) - 1;
+    htim8.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim8.Init.RepetitionCounter = 0;
+    htim8.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_Base_Init(&htim8) != HAL_OK)
+    {
+        Error_Handler();
+    }
+
+    hdma_audio.Instance = DMA2_Stream1;
+    hdma_audio.Init.Channel = DMA_CHANNEL_7;
+    hdma_audio.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_audio.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_audio.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_audio.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_audio.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    hdma_audio.Init.Mode = DMA_CIRCULAR;
+    hdma_audio.Init.Priority = DMA_PRIORITY_HIGH; // Underruns are audible
+    hdma_audio.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_audio) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    hdma_audio.XferHalfCpltCallback = Mixer_HalfCallback;
+    hdma_audio.XferCpltCallback = Mixer_FullCallback;
+
+    /* Same level as other RTOS-aware interrupts, below LTDC/DMA2D */
+    HAL_NVIC_SetPriority(DMA2_Stream1_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+
+    HAL_DMA_Start_IT(&hdma_audio, (uint32_t)dmaBuffer, (uint32_t)&htim10.Instance->CCR1, AUDIO_BUFFER_SAMPLES);
+    __HAL_TIM_ENABLE_DMA(&htim8, TIM_DMA_UPDATE);
+    __HAL_TIM_ENABLE(&htim8);
+}
+
+void AudioMixer_PlaySong(MixerVoice first, uint8_t voiceCount, const TrackerSong* song, uint8_t loop)
+{
+    uint32_t pairsPerTick = ((uint32_t)song->tickMs * AUDIO_SAMPLE_RATE + 1000) / 2000;
+    uint32_t k;
+
+    if (first + voiceCount > MIXER_VOICE_COUNT)
+    {
+        voiceCount = MIXER_VOICE_COUNT - first;
+    }
+
+    Mixer_Lock();
+    for (k = 0; k < voiceCount; k++)
+    {
+        Voice* v = &voices[first + k];
+
+        if (k < song->channelCount)
+        {
+            Tracker_Start(&v->player, song, (uint8_t)k, loop);
+        }
+        else
+        {
+            v->player.song = NULL;
+        }
+        v->pairsPerTick = pairsPerTick;
+        v->pairsLeft = 0; // First row is decoded by the next render
+        v->phaseInc = 0;
+    }
+    Mixer_Unlock();
+}
+
+void AudioMixer_StopVoice(MixerVoice voice)
+{
+    Mixer_Lock();
+    voices[voice].player.song = NULL;
+    voices[voice].phaseInc = 0;
+    Mixer_Unlock();
+}
+
+void AudioMixer_StopAll(void)
+{
+    uint32_t k;
+
+    Mixer_Lock();
+    for (k = 0; k < MIXER_VOICE_COUNT; k++)
+    {
+        voices[k].player.song = NULL;
+        voices[k].phaseInc = 0;
+    }
+    Mixer_Unlock();
+}
+
+uint8_t AudioMixer_IsVoiceActive(MixerVoice voice)
+{
+    return (voices[voice].player.song != NULL) ? 1 : 0;
+}
+
+void AudioMixer_SetVoiceGain(MixerVoice voice, uint16_t gain, uint16_t rampMs)
+{
+    Mixer_Lock();
+    voices[voice].level = (gain > GAIN_UNITY) ? GAIN_UNITY : gain;
+    voices[voice].gainStep = Ramp_Step(rampMs);
+    Mixer_Unlock();
+}
+
+void AudioMixer_PauseVoice(MixerVoice voice, uint8_t pause, uint16_t rampMs)
+{
+    Mixer_Lock();
+    voices[voice].paused = pause;
+    voices[voice].gainStep = Ramp_Step(rampMs);
+    Mixer_Unlock();
+}
+
+void AudioMixer_SetVolume(uint8_t volume)
+{
+    if (volume > 100) volume = 100;
+    voiceAmp = (VOICE_MAX_AMP * volume) / 100;
+}
+
+void AudioMixer_GetStats(AudioMixer_Stats* out)
+{
+    *out = stats;
+}
+
+RAM_FUNC void AudioMixer_DMA_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_audio);
+}
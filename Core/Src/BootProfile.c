@@ -0,0 +1,122 @@
+/*
+ * BootProfile.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "BootProfile.h"
+#include "stm32f4xx_hal.h"
+#include <stdio.h>
+
+static const char* const stageNames[BOOT_STAGE_COUNT] = {
+    "main", "hal", "clock", "sdram", "lcd", "peripherals", "memory", "rtos", "gui", "panel", "first_frame"
+};
+
+/* Internal State (written with interrupts masked: marks come from tasks and ISRs) */
+static uint32_t stageUs[BOOT_STAGE_COUNT];
+static volatile uint32_t reached;  // Bit per stage
+static uint32_t lastCycles;        // Cycle count at the latest mark
+static uint32_t lastUs;            // Its time since main()
+static uint32_t lastClock;         // SystemCoreClock at the latest mark
+
+/* API Implementation */
+
+void BootProfile_Start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    lastCycles = 0;
+    lastUs = 0;
+    lastClock = SystemCoreClock;
+    stageUs[BOOT_STAGE_MAIN] = 0;
+    reached = 1U << BOOT_STAGE_MAIN;
+}
+
+void BootProfile_Mark(BootProfile_Stage stage)
+{
+    uint32_t primask;
+    uint32_t now;
+
+    if (stage >= BOOT_STAGE_COUNT || (reached & (1U << stage)))
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (!(reached & (1U << stage)))
+    {
+        /* The core clock changes once (16 MHz HSI -> 168 MHz PLL), so cycles
+           are converted per interval, at the clock the interval started with.
+           The cycle counter wraps after 25 s, far beyond any boot */
+        now = DWT->CYCCNT;
+        lastUs += (uint32_t)(((uint64_t)(now - lastCycles) * 1000000U) / lastClock);
+        lastCycles = now;
+        lastClock = SystemCoreClock;
+        stageUs[stage] = lastUs;
+        reached |= 1U << stage;
+    }
+    __set_PRIMASK(primask);
+}
+
+void BootProfile_DelayUs(uint32_t us)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t cycles = (uint32_t)(((uint64_t)SystemCoreClock * us) / 1000000U);
+
+    while (DWT->CYCCNT - start < cycles) {}
+}
+
+uint8_t BootProfile_IsComplete(void)
+{
+    return (reached & (1U << BOOT_STAGE_FIRST_FRAME)) != 0;
+}
+
+void BootProfile_GetReport(BootProfile_Report* report)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint8_t i;
+
+    __disable_irq();
+    for (i = 0; i < BOOT_STAGE_COUNT; i++)
+    {
+        report->stageUs[i] = (reached & (1U << i)) ? stageUs[i] : BOOT_NOT_REACHED;
+    }
+    __set_PRIMASK(primask);
+
+    report->budgetUs = BOOT_FIRST_FRAME_BUDGET_MS * 1000U;
+    report->fast = BOOT_FAST;
+}
+
+/* {"boot":{"fast":1,"budget_us":100000,"first_frame_us":61250,"over":0,
+   "stages":{"main":0,"hal":212,"clock":1630,...}}}; -1 = not reached */
+int BootProfile_Format(const BootProfile_Report* report, char* buffer, uint32_t size)
+{
+    uint32_t firstFrame = report->stageUs[BOOT_STAGE_FIRST_FRAME];
+    uint32_t used;
+    int n;
+    uint8_t i;
+
+    n = snprintf(buffer, size, "{\"boot\":{\"fast\":%u,\"budget_us\":%lu,\"first_frame_us\":%ld,\"over\":%u,\"stages\":{",
+                 report->fast, (unsigned long)report->budgetUs,
+                 (firstFrame == BOOT_NOT_REACHED) ? -1L : (long)firstFrame,
+                 (firstFrame == BOOT_NOT_REACHED || firstFrame > report->budgetUs) ? 1U : 0U);
+    if (n < 0 || (uint32_t)n >= size) return -1;
+    used = n;
+
+    for (i = 0; i < BOOT_STAGE_COUNT; i++)
+    {
+        uint32_t us = report->stageUs[i];
+        n = snprintf(buffer + used, size - used, "%s\"%s\":%ld",
+                     (i > 0) ? "," : "", stageNames[i],
+                     (us == BOOT_NOT_REACHED) ? -1L : (long)us);
+        if (n < 0 || (uint32_t)n >= size - used) return -1;
+        used += n;
+    }
+
+    n = snprintf(buffer + used, size - used, "}}}\r\n");
+    if (n < 0 || (uint32_t)n >= size - used) return -1;
+    return used + n;
+}
@@ -0,0 +1,151 @@
+/*
+ * EntropyPool.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "EntropyPool.h"
+#include "stm32f4xx_hal.h"
+#include "CcmRam.h"
+
+/* External RNG Handle */
+extern RNG_HandleTypeDef hrng;
+
+#define POOL_MASK (ENTROPY_POOL_SIZE - 1U)
+
+/* Internal State */
+/* Single producer (RNG interrupt) writes head, single consumer (GUI task) writes tail.
+ * Both indices run freely; (head - tail) is the number of buffered words. */
+static uint32_t pool[ENTROPY_POOL_SIZE] CCM_BSS; // Filled by the CPU in the RNG interrupt, no DMA
+static volatile uint32_t poolHead = 0;
+static volatile uint32_t poolTail = 0;
+static volatile uint8_t filling = 0; // An interrupt-driven conversion is in flight
+static volatile EntropyPool_Stats stats;
+
+/* Helper: Push one word (producer side) */
+static uint8_t Push(uint32_t value)
+{
+    if ((poolHead - poolTail) >= ENTROPY_POOL_SIZE)
+    {
+        return 0;
+    }
+    pool[poolHead & POOL_MASK] = value;
+    poolHead++;
+    stats.wordsGenerated++;
+    return 1;
+}
+
+/* Helper: Restart interrupt-driven filling (consumer side) */
+static void Refill(void)
+{
+    /* Keep the RNG interrupt out while we look at the handle state */
+    HAL_NVIC_DisableIRQ(HASH_RNG_IRQn);
+
+    if (!filling)
+    {
+        if (hrng.State == HAL_RNG_STATE_ERROR)
+        {
+            /* Seed/clock error recovery: restart the analog source, drop the lock
+               the aborted conversion left behind */
+            __HAL_RNG_DISABLE(&hrng);
+            __HAL_RNG_ENABLE(&hrng);
+            hrng.ErrorCode = HAL_RNG_ERROR_NONE;
+            hrng.State = HAL_RNG_STATE_READY;
+            __HAL_UNLOCK(&hrng);
+        }
+
+        if (HAL_RNG_GenerateRandomNumber_IT(&hrng) == HAL_OK)
+        {
+            filling = 1;
+        }
+    }
+
+    HAL_NVIC_EnableIRQ(HASH_RNG_IRQn);
+}
+
+/* API Implementation */
+
+void EntropyPool_Init(void)
+{
+    uint32_t value;
+
+    /* Prime the pool synchronously so the first pieces drawn during
+       TouchGFX start-up (before interrupts run) are already random */
+    while ((poolHead - poolTail) < ENTROPY_POOL_SIZE)
+    {
+        if (HAL_RNG_GenerateRandomNumber(&hrng, &value) != HAL_OK)
+        {
+            break;
+        }
+        Push(value);
+    }
+}
+
+uint8_t EntropyPool_Take(uint32_t* value)
+{
+    uint32_t tail = poolTail;
+
+    if (poolHead == tail)
+    {
+        stats.underruns++;
+        Refill();
+        return 0;
+    }
+
+    *value = pool[tail & POOL_MASK];
+    poolTail = tail + 1;
+    stats.wordsTaken++;
+
+    /* A slot is free again, make sure the interrupt keeps topping up */
+    if (!filling)
+    {
+        Refill();
+    }
+    return 1;
+}
+
+void EntropyPool_GetStats(EntropyPool_Stats* out)
+{
+    *out = stats;
+}
+
+/* RNG Interrupt Callbacks (override HAL weak definitions) */
+
+void HAL_RNG_ReadyDataCallback(RNG_HandleTypeDef* handle, uint32_t random32bit)
+{
+    if (handle->Instance != RNG)
+    {
+        return;
+    }
+
+    Push(random32bit);
+
+    /* Chain the next conversion until the pool is full */
+    if ((poolHead - poolTail) >= ENTROPY_POOL_SIZE ||
+        HAL_RNG_GenerateRandomNumber_IT(handle) != HAL_OK)
+    {
+        filling = 0;
+    }
+}
+
+void HAL_RNG_ErrorCallback(RNG_HandleTypeDef* handle)
+{
+    if (handle->Instance != RNG)
+    {
+        return;
+    }
+
+    if (__HAL_RNG_GET_IT(handle, RNG_IT_CEI) != RESET)
+    {
+        stats.clockErrors++;
+    }
+    if (__HAL_RNG_GET_IT(handle, RNG_IT_SEI) != RESET)
+    {
+        stats.seedErrors++;
+    }
+
+    /* Stop here; the next Take() restarts the source from task context,
+       so a persistent clock fault cannot turn into an interrupt storm */
+    __HAL_RNG_DISABLE_IT(handle);
+    filling = 0;
+}
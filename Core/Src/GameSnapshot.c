@@ -0,0 +1,95 @@
+/*
+ * GameSnapshot.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "GameSnapshot.h"
+#include "CcmRam.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Internal State */
+/* Double buffer with one seqlock counter per slot. The writer fills the slot
+ * readers are not directed to (odd counter while it writes), then points
+ * 'published' at it. A reader copies the published slot and retries only if
+ * that slot's counter moved meanwhile, i.e. if it was preempted for two
+ * whole publishes. Nobody takes a lock or masks interrupts. */
+static GameSnapshot slots[2] CCM_BSS;            // CPU only, no DMA
+static volatile uint32_t slotSequence[2] CCM_BSS; // Odd = slot being written
+static volatile uint32_t published CCM_BSS;       // Publish count; slot (published & 1)
+
+/* API Implementation */
+
+void GameSnapshot_Publish(const GameSnapshot* snapshot)
+{
+    const uint32_t next = published + 1U;
+    const uint32_t slot = next & 1U;
+
+    slotSequence[slot]++;
+    __DMB(); // Counter odd before any field changes
+
+    slots[slot] = *snapshot;
+    slots[slot].sequence = next;
+
+    __DMB(); // Fields complete before the counter is even again
+    slotSequence[slot]++;
+    __DMB();
+    published = next;
+}
+
+uint32_t GameSnapshot_Read(GameSnapshot* snapshot)
+{
+    uint32_t slot;
+    uint32_t before;
+
+    for (;;)
+    {
+        slot = published & 1U;
+        before = slotSequence[slot];
+        if (before & 1U)
+        {
+            continue; // Writer lapped us and is refilling this slot
+        }
+        __DMB();
+
+        memcpy(snapshot, &slots[slot], sizeof(*snapshot));
+
+        __DMB();
+        if (slotSequence[slot] == before)
+        {
+            return snapshot->sequence;
+        }
+    }
+}
+
+/* {"game":{"seq":412,"piece":5,"x":3,"y":7,"rot":1,"next":2,"held":255,
+   "flags":8,"level":2,"score":1840,"lines":14,"rows":"000...3ff"}} */
+int GameSnapshot_Format(const GameSnapshot* snapshot, char* buffer, uint32_t size)
+{
+    int n;
+    uint32_t used;
+    uint32_t y;
+
+    n = snprintf(buffer, size,
+                 "{\"game\":{\"seq\":%lu,\"piece\":%u,\"x\":%d,\"y\":%d,\"rot\":%u,\"next\":%u,"
+                 "\"held\":%u,\"flags\":%u,\"level\":%u,\"score\":%lu,\"lines\":%lu,\"rows\":\"",
+                 (unsigned long)snapshot->sequence, snapshot->piece, snapshot->pieceX,
+                 snapshot->pieceY, snapshot->pieceRotation, snapshot->nextPiece,
+                 snapshot->heldPiece, snapshot->flags, snapshot->level,
+                 (unsigned long)snapshot->score, (unsigned long)snapshot->lines);
+    if (n < 0 || (uint32_t)n >= size) return -1;
+    used = (uint32_t)n;
+
+    // Bitboard as 3 hex digits per row, top row first
+    for (y = 0; y < GAMESNAPSHOT_ROWS; y++)
+    {
+        n = snprintf(buffer + used, size - used, "%03x", (unsigned)snapshot->rows[y]);
+        if (n < 0 || (uint32_t)n >= size - used) return -1;
+        used += (uint32_t)n;
+    }
+
+    n = snprintf(buffer + used, size - used, "\"}}\r\n");
+    if (n < 0 || (uint32_t)n >= size - used) return -1;
+    return (int)(used + (uint32_t)n);
+}
@@ -0,0 +1,325 @@
+/*
+ * LcdCommand.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "LcdCommand.h"
+#include "BootProfile.h"
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include <string.h>
+
+extern SPI_HandleTypeDef hspi5;
+
+/* ILI9341 control lines (as LCD_IO_* in main.c) */
+#define LCD_CS_PORT        GPIOC
+#define LCD_CS_PIN         GPIO_PIN_2
+#define LCD_WRX_PORT       GPIOD    // D/CX: low = command, high = parameters
+#define LCD_WRX_PIN        GPIO_PIN_13
+
+#define ENTRY_DELAY        0xFFU    // Length byte of an LCDCMD_DELAY entry
+#define SPI_BR_MASK        SPI_CR1_BR
+
+typedef enum {
+    ENGINE_IDLE,
+    ENGINE_RUNNING,   // Advance() owns the bus
+    ENGINE_DMA,       // Parameters in flight, resumes from the DMA callback
+    ENGINE_DELAY      // Resumes from LcdCommand_Tick
+} Engine_State;
+
+/* ILI9341 power-up sequence of the BSP driver (ili9341_Init). Its two 200 ms
+   waits are cut to what the datasheet asks for: 5 ms after Sleep Out before
+   the next command; Display On is sent later, after the first frame */
+static const uint8_t panelInit[] = {
+    LCDCMD(0xCA, 3), 0xC3, 0x08, 0x50,
+    LCDCMD(0xCF, 3), 0x00, 0xC1, 0x30,                   // Power control B
+    LCDCMD(0xED, 4), 0x64, 0x03, 0x12, 0x81,             // Power on sequence
+    LCDCMD(0xE8, 3), 0x85, 0x00, 0x78,                   // Driver timing A
+    LCDCMD(0xCB, 5), 0x39, 0x2C, 0x00, 0x34, 0x02,       // Power control A
+    LCDCMD(0xF7, 1), 0x20,                               // Pump ratio
+    LCDCMD(0xEA, 2), 0x00, 0x00,                         // Driver timing B
+    LCDCMD(0xB1, 2), 0x00, 0x1B,                         // Frame rate
+    LCDCMD(0xB6, 2), 0x0A, 0xA2,                         // Display function
+    LCDCMD(0xC0, 1), 0x10,                               // Power control 1
+    LCDCMD(0xC1, 1), 0x10,                               // Power control 2
+    LCDCMD(0xC5, 2), 0x45, 0x15,                         // VCOM 1
+    LCDCMD(0xC7, 1), 0x90,                               // VCOM 2
+    LCDCMD(0x36, 1), 0xC8,                               // Memory access
+    LCDCMD(0xF2, 1), 0x00,                               // 3 gamma off
+    LCDCMD(0xB0, 1), 0xC2,                               // RGB interface
+    LCDCMD(0xB6, 4), 0x0A, 0xA7, 0x27, 0x04,             // Display function
+    LCDCMD(0x2A, 4), 0x00, 0x00, 0x00, 0xEF,             // Columns 0..239
+    LCDCMD(0x2B, 4), 0x00, 0x00, 0x01, 0x3F,             // Pages 0..319
+    LCDCMD(0xF6, 3), 0x01, 0x00, 0x06,                   // Interface (RGB)
+    LCDCMD(0x2C, 0),                                     // GRAM
+    LCDCMD(0x26, 1), 0x01,                               // Gamma curve 1
+    LCDCMD(0xE0, 15), 0x0F, 0x29, 0x24, 0x0C, 0x0E, 0x09, 0x4E, 0x78,
+                      0x3C, 0x09, 0x13, 0x05, 0x17, 0x11, 0x00,  // Positive gamma
+    LCDCMD(0xE1, 15), 0x00, 0x16, 0x1B, 0x04, 0x11, 0x07, 0x31, 0x33,
+                      0x42, 0x05, 0x0C, 0x0A, 0x28, 0x2F, 0x0F,  // Negative gamma
+    LCDCMD(0x11, 0),                                     // Sleep out
+    LCDCMD_DELAY(5),
+    LCDCMD(0x28, 0),                                     // Display off until TouchGFX has a frame
+    LCDCMD(0x2C, 0),
+};
+
+/* Internal State */
+static DMA_HandleTypeDef hdma_lcd;       // SPI5_TX (DMA2 Stream4 Ch2)
+static uint8_t buffer[LCDCMD_BUFFER_SIZE]; // DMA source: main SRAM, never CCM
+static volatile uint16_t head;           // Written by Submit (interrupts masked)
+static volatile uint16_t tail;           // Written by the engine
+static uint16_t dmaEnd;                  // tail once the DMA completes
+static volatile Engine_State state = ENGINE_IDLE;
+static volatile uint32_t resumeTick;
+static uint32_t initStartMs;
+static uint8_t initPending;
+static volatile LcdCommand_Stats stats;
+
+/* Helper: Select the panel and the list clock (LCDCMD_SPI_PRESCALER) for a run of commands */
+static void Bus_Begin(void)
+{
+    __HAL_SPI_DISABLE(&hspi5);
+    MODIFY_REG(hspi5.Instance->CR1, SPI_BR_MASK, LCDCMD_SPI_PRESCALER);
+    __HAL_SPI_ENABLE(&hspi5);
+    HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_RESET);
+}
+
+/* Helper: Deselect and restore the CubeMX clock */
+static void Bus_End(void)
+{
+    HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_SET);
+    __HAL_SPI_DISABLE(&hspi5);
+    MODIFY_REG(hspi5.Instance->CR1, SPI_BR_MASK, hspi5.Init.BaudRatePrescaler);
+}
+
+/* Helper: Short writes go straight to DR; cheaper than setting up a DMA */
+static void Write_Polled(const uint8_t* data, uint16_t count)
+{
+    SPI_TypeDef* spi = hspi5.Instance;
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        while (!(spi->SR & SPI_SR_TXE)) {}
+        *(volatile uint8_t*)&spi->DR = data[i];
+    }
+    while (!(spi->SR & SPI_SR_TXE)) {}
+    while (spi->SR & SPI_SR_BSY) {}
+    __HAL_SPI_CLEAR_OVRFLAG(&hspi5); // Transmit only: drop what was clocked in
+}
+
+/* Helper: Send queued entries until the buffer is empty, a delay entry or
+   a DMA transfer. Runs in whichever context resumed the engine; only one
+   context can own it at a time (state) */
+static void Advance(void)
+{
+    for (;;)
+    {
+        uint16_t t = tail;
+        uint8_t cmd, len;
+
+        if (t == head)
+        {
+            uint32_t primask = __get_PRIMASK();
+            uint8_t done;
+
+            __disable_irq();
+            done = (tail == head);
+            if (done)
+            {
+                head = tail = 0;
+                state = ENGINE_IDLE;
+            }
+            __set_PRIMASK(primask);
+
+            if (done)
+            {
+                Bus_End();
+                if (initPending)
+                {
+                    stats.initMs = HAL_GetTick() - initStartMs;
+                    initPending = 0;
+                    BootProfile_Mark(BOOT_STAGE_PANEL);
+                }
+                return;
+            }
+            continue; // Submit appended meanwhile
+        }
+
+        cmd = buffer[t];
+        len = buffer[t + 1U];
+
+        if (len == ENTRY_DELAY)
+        {
+            tail = t + 3U;
+            resumeTick = HAL_GetTick() + buffer[t + 2U] + 1U; // +1: the current ms is partly gone
+            state = ENGINE_DELAY;
+            return;
+        }
+
+        HAL_GPIO_WritePin(LCD_WRX_PORT, LCD_WRX_PIN, GPIO_PIN_RESET);
+        Write_Polled(&cmd, 1);
+        HAL_GPIO_WritePin(LCD_WRX_PORT, LCD_WRX_PIN, GPIO_PIN_SET);
+        stats.commands++;
+        stats.bytes += 1U + len;
+
+        if (len > LCDCMD_POLL_MAX)
+        {
+            dmaEnd = t + 2U + len;
+            state = ENGINE_DMA;
+            stats.dmaTransfers++;
+            if (HAL_SPI_Transmit_DMA(&hspi5, &buffer[t + 2U], len) != HAL_OK)
+            {
+                Write_Polled(&buffer[t + 2U], len); // Not expected; keep the list going
+                state = ENGINE_RUNNING;
+                tail = dmaEnd;
+            }
+            else
+            {
+                return;
+            }
+        }
+        else
+        {
+            Write_Polled(&buffer[t + 2U], len);
+            tail = t + 2U + len;
+        }
+    }
+}
+
+/* API Implementation */
+
+void LcdCommand_Init(void)
+{
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    hdma_lcd.Instance = DMA2_Stream4;
+    hdma_lcd.Init.Channel = DMA_CHANNEL_2;
+    hdma_lcd.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_lcd.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_lcd.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_lcd.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_lcd.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_lcd.Init.Mode = DMA_NORMAL;
+    hdma_lcd.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_lcd.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_lcd) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    __HAL_LINKDMA(&hspi5, hdmatx, hdma_lcd);
+
+    /* Same level as other RTOS-aware interrupts; SPI5's own IRQ stays off */
+    HAL_NVIC_SetPriority(DMA2_Stream4_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream4_IRQn);
+
+    /* Pulse CS once, as LCD_IO_Init does */
+    HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_SET);
+
+    initStartMs = HAL_GetTick();
+    initPending = 1;
+    LcdCommand_Submit(panelInit, sizeof(panelInit));
+}
+
+uint8_t LcdCommand_Submit(const uint8_t* list, uint16_t size)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint8_t start = 0;
+
+    /* Copying with interrupts masked keeps head/tail consistent with the
+       engine resetting them when it runs dry (a few hundred ns per list) */
+    __disable_irq();
+    if ((uint32_t)head + size > LCDCMD_BUFFER_SIZE)
+    {
+        __set_PRIMASK(primask);
+        stats.rejected++;
+        return 0;
+    }
+    memcpy(&buffer[head], list, size);
+    head += size;
+    if (state == ENGINE_IDLE)
+    {
+        state = ENGINE_RUNNING;
+        start = 1;
+    }
+    __set_PRIMASK(primask);
+
+    if (start)
+    {
+        Bus_Begin();
+        Advance();
+    }
+    return 1;
+}
+
+uint8_t LcdCommand_Write(uint8_t cmd, const uint8_t* params, uint8_t count)
+{
+    uint8_t entry[2U + 16U];
+
+    if (count > 16U)
+    {
+        return 0;
+    }
+    entry[0] = cmd;
+    entry[1] = count;
+    if (count > 0)
+    {
+        memcpy(&entry[2], params, count);
+    }
+    return LcdCommand_Submit(entry, 2U + count);
+}
+
+uint8_t LcdCommand_IsBusy(void)
+{
+    return state != ENGINE_IDLE;
+}
+
+void LcdCommand_Flush(void)
+{
+    while (state != ENGINE_IDLE)
+    {
+        if (osKernelGetState() == osKernelRunning)
+        {
+            osDelay(1);
+        }
+    }
+}
+
+void LcdCommand_GetStats(LcdCommand_Stats* out)
+{
+    *out = stats;
+}
+
+void LcdCommand_Tick(void)
+{
+    if (state == ENGINE_DELAY && (int32_t)(HAL_GetTick() - resumeTick) >= 0)
+    {
+        state = ENGINE_RUNNING;
+        Advance();
+    }
+}
+
+void LcdCommand_DMA_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_lcd);
+}
+
+/* HAL SPI Callbacks (SPI5 DMA is only used here) */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    if (hspi != &hspi5 || state != ENGINE_DMA)
+    {
+        return;
+    }
+    tail = dmaEnd;
+    state = ENGINE_RUNNING;
+    Advance();
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi)
+{
+    /* The parameters are lost; skip them rather than stall the queue */
+    HAL_SPI_TxCpltCallback(hspi);
+}
@@ -0,0 +1,193 @@
+/*
+ * MemoryMonitor.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "MemoryMonitor.h"
+#include "Trace.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TRACKED_TASKS (MEMORY_MAX_TASKS + 1) // Task numbers start at 1
+
+extern UART_HandleTypeDef huart1;
+
+/* Internal State */
+static uint32_t stackBytes[TRACKED_TASKS]; // Filled at task creation
+static TaskStatus_t taskStatus[MEMORY_MAX_TASKS];
+static MemoryMonitor_Report sample;
+static MemoryMonitor_Report latest; // Guarded by a critical section
+
+/* Helper: Deepest use + margin, rounded up */
+static uint32_t Suggest_Stack(uint32_t used)
+{
+    uint32_t margin = used * MEMORY_STACK_MARGIN_PCT / 100U;
+
+    if (margin < MEMORY_STACK_MARGIN_MIN)
+    {
+        margin = MEMORY_STACK_MARGIN_MIN;
+    }
+    return (used + margin + MEMORY_STACK_ROUND - 1) & ~(MEMORY_STACK_ROUND - 1);
+}
+
+/* Helper: Last words before halting. Interrupts are masked here, so the
+   UART is polled; an interrupt-driven profiler dump is cut short first. */
+static void Fatal_Report(const char* message)
+{
+    HAL_UART_AbortTransmit(&huart1);
+    HAL_UART_Transmit(&huart1, (uint8_t*)message, strlen(message), HAL_MAX_DELAY);
+
+    __disable_irq();
+    if (CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk)
+    {
+        __BKPT(0);
+    }
+    for(;;)
+    {
+    }
+}
+
+/* API Implementation */
+
+void MemoryMonitor_Update(void)
+{
+    MemoryMonitor_Sample(&sample);
+
+    taskENTER_CRITICAL();
+    latest = sample;
+    taskEXIT_CRITICAL();
+}
+
+void MemoryMonitor_GetReport(MemoryMonitor_Report* report)
+{
+    taskENTER_CRITICAL();
+    *report = latest;
+    taskEXIT_CRITICAL();
+}
+
+void MemoryMonitor_Sample(MemoryMonitor_Report* report)
+{
+    HeapStats_t heap;
+    UBaseType_t count;
+    UBaseType_t i;
+
+    vPortGetHeapStats(&heap);
+    report->heapSize = configTOTAL_HEAP_SIZE;
+    report->heapFree = heap.xAvailableHeapSpaceInBytes;
+    report->heapMinEverFree = heap.xMinimumEverFreeBytesRemaining;
+    report->heapLargestFree = heap.xSizeOfLargestFreeBlockInBytes;
+    report->heapFreeBlocks = heap.xNumberOfFreeBlocks;
+    report->fragmentationPermille = (heap.xAvailableHeapSpaceInBytes > 0)
+        ? (uint16_t)(1000U - (uint32_t)(((uint64_t)heap.xSizeOfLargestFreeBlockInBytes * 1000U) / heap.xAvailableHeapSpaceInBytes))
+        : 0;
+    report->allocations = heap.xNumberOfSuccessfulAllocations;
+    report->frees = heap.xNumberOfSuccessfulFrees;
+
+    report->stackTotal = 0;
+    report->stackSuggestedTotal = 0;
+    report->taskCount = 0;
+
+    count = uxTaskGetSystemState(taskStatus, MEMORY_MAX_TASKS, NULL);
+
+    for (i = 0; i < count; i++)
+    {
+        const TaskStatus_t* status = &taskStatus[i];
+        uint32_t number = status->xTaskNumber;
+        uint32_t freeBytes = (uint32_t)status->usStackHighWaterMark * sizeof(StackType_t);
+        MemoryMonitor_Task task;
+        int slot;
+
+        if (number >= TRACKED_TASKS || stackBytes[number] == 0)
+        {
+            continue;
+        }
+
+        strncpy(task.name, status->pcTaskName, MEMORY_NAME_LEN - 1);
+        task.name[MEMORY_NAME_LEN - 1] = '\0';
+        task.stackBytes = stackBytes[number];
+        task.usedBytes = (freeBytes < task.stackBytes) ? task.stackBytes - freeBytes : 0;
+        task.suggestedBytes = Suggest_Stack(task.usedBytes);
+
+        report->stackTotal += task.stackBytes;
+        report->stackSuggestedTotal += task.suggestedBytes;
+
+        // Insertion sort, largest stack first
+        slot = report->taskCount++;
+        while (slot > 0 && report->tasks[slot - 1].stackBytes < task.stackBytes)
+        {
+            report->tasks[slot] = report->tasks[slot - 1];
+            slot--;
+        }
+        report->tasks[slot] = task;
+    }
+}
+
+/* {"memory":{"heap_size":65536,"heap_free":20480,"heap_min_free":19876,
+   "largest_free":20000,"free_blocks":2,"fragmentation":2.3,"allocs":14,
+   "frees":0,"stack_total":38912,"stack_suggested":6144,"tasks":[{"name":
+   "GUI_Task","stack":32768,"used":3100,"suggested":3904},...]}} */
+int MemoryMonitor_Format(const MemoryMonitor_Report* report, char* buffer, uint32_t size)
+{
+    uint32_t used;
+    int n;
+    uint8_t i;
+
+    n = snprintf(buffer, size,
+                 "{\"memory\":{\"heap_size\":%lu,\"heap_free\":%lu,\"heap_min_free\":%lu,"
+                 "\"largest_free\":%lu,\"free_blocks\":%lu,\"fragmentation\":%u.%u,"
+                 "\"allocs\":%lu,\"frees\":%lu,\"stack_total\":%lu,\"stack_suggested\":%lu,\"tasks\":[",
+                 (unsigned long)report->heapSize, (unsigned long)report->heapFree,
+                 (unsigned long)report->heapMinEverFree, (unsigned long)report->heapLargestFree,
+                 (unsigned long)report->heapFreeBlocks,
+                 report->fragmentationPermille / 10, report->fragmentationPermille % 10,
+                 (unsigned long)report->allocations, (unsigned long)report->frees,
+                 (unsigned long)report->stackTotal, (unsigned long)report->stackSuggestedTotal);
+    if (n < 0 || (uint32_t)n >= size) return -1;
+    used = n;
+
+    for (i = 0; i < report->taskCount; i++)
+    {
+        const MemoryMonitor_Task* t = &report->tasks[i];
+        n = snprintf(buffer + used, size - used,
+                     "%s{\"name\":\"%s\",\"stack\":%lu,\"used\":%lu,\"suggested\":%lu}",
+                     (i > 0) ? "," : "", t->name, (unsigned long)t->stackBytes,
+                     (unsigned long)t->usedBytes, (unsigned long)t->suggestedBytes);
+        if (n < 0 || (uint32_t)n >= size - used) return -1;
+        used += n;
+    }
+
+    n = snprintf(buffer + used, size - used, "]}}\r\n");
+    if (n < 0 || (uint32_t)n >= size - used) return -1;
+    return used + n;
+}
+
+void MemoryMonitor_TaskCreated(uint32_t taskNumber, uint32_t bytes)
+{
+    if (taskNumber < TRACKED_TASKS)
+    {
+        stackBytes[taskNumber] = bytes;
+    }
+}
+
+void MemoryMonitor_StackOverflow(const char* taskName)
+{
+    char message[64];
+
+    TRACE_EVENT(TRACE_EVT_STACK_OVERFLOW, 0);
+    snprintf(message, sizeof(message), "{\"fatal\":\"stack_overflow\",\"task\":\"%s\"}\r\n", taskName);
+    Fatal_Report(message);
+}
+
+void MemoryMonitor_MallocFailed(void)
+{
+    char message[96];
+
+    TRACE_EVENT(TRACE_EVT_MALLOC_FAILED, 0);
+    snprintf(message, sizeof(message), "{\"fatal\":\"malloc_failed\",\"heap_free\":%lu,\"task\":\"%s\"}\r\n",
+             (unsigned long)xPortGetFreeHeapSize(),
+             (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) ? "" : pcTaskGetName(NULL));
+    Fatal_Report(message);
+}
@@ -0,0 +1,51 @@
+/*
+ * MusicData.c
+ *
+ * Generated by tools/music_convert.py from tools/music - do not edit
+ */
+
+#include "MusicData.h"
+
+/* game.song */
+static const uint8_t song_game_p0[] = { 0x81, 0x35, 0x80, 0x30, 0x31, 0x81, 0x33, 0x80, 0x31, 0x30, 0xFF };
+static const uint8_t song_game_p1[] = { 0x81, 0x2E, 0x80, 0x2E, 0x31, 0x81, 0x35, 0x80, 0x33, 0x31, 0xFF };
+static const uint8_t song_game_p2[] = { 0x82, 0x30, 0x80, 0x31, 0x81, 0x33, 0x35, 0xFF };
+static const uint8_t song_game_p3[] = { 0x81, 0x31, 0x2E, 0x83, 0x2E, 0xFF };
+static const uint8_t song_game_p4[] = { 0x80, 0x11, 0x1D, 0x11, 0x1D, 0x11, 0x1D, 0x11, 0x1D, 0xFF };
+static const uint8_t song_game_p5[] = { 0x80, 0x16, 0x22, 0x16, 0x22, 0x16, 0x22, 0x16, 0x22, 0xFF };
+static const uint8_t* const song_game_patterns[] = { song_game_p0, song_game_p1, song_game_p2, song_game_p3, song_game_p4, song_game_p5 };
+static const uint8_t song_game_lead[] = { 0x00, 0x01, 0x02, 0x03, 0xFF };
+static const uint8_t song_game_bass[] = { 0x04, 0x05, 0x04, 0x05, 0xFF };
+const TrackerSong song_game = {
+    200, 2, song_game_patterns,
+    { song_game_lead, song_game_bass }
+};
+
+/* gameover.song */
+static const uint8_t song_gameover_p0[] = { 0x82, 0x30, 0x2A, 0x27, 0x87, 0x25, 0xFF };
+static const uint8_t* const song_gameover_patterns[] = { song_gameover_p0 };
+static const uint8_t song_gameover_lead[] = { 0x00, 0xFF };
+const TrackerSong song_gameover = {
+    100, 1, song_gameover_patterns,
+    { song_gameover_lead }
+};
+
+/* lineclear.song */
+static const uint8_t song_clear_p0[] = { 0x84, 0x35, 0x93, 0x3A, 0xFF };
+static const uint8_t song_clear_p1[] = { 0x82, 0x60, 0x54, 0xFF };
+static const uint8_t* const song_clear_patterns[] = { song_clear_p0, song_clear_p1 };
+static const uint8_t song_clear_lead[] = { 0x00, 0xFF };
+static const uint8_t song_clear_noise[] = { 0x01, 0xFF };
+const TrackerSong song_clear = {
+    20, 2, song_clear_patterns,
+    { song_clear_lead, song_clear_noise }
+};
+
+/* menu.song */
+static const uint8_t song_menu_p0[] = { 0x80, 0x31, 0x35, 0x38, 0x35, 0x31, 0x2C, 0x81, 0x31, 0xFF };
+static const uint8_t* const song_menu_patterns[] = { song_menu_p0 };
+static const uint8_t song_menu_lead[] = { 0x00, 0xFF };
+const TrackerSong song_menu = {
+    300, 1, song_menu_patterns,
+    { song_menu_lead }
+};
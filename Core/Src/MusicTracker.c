@@ -0,0 +1,101 @@
+/*
+ * MusicTracker.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "MusicTracker.h"
+
+/* Order entries a channel may skip without producing a row before it is
+   treated as finished (guards against songs made only of empty patterns) */
+#define TRACKER_MAX_EMPTY_ORDERS 256
+
+/* Equal temperament, A4 (note 46) = 440 Hz */
+const uint32_t Tracker_NoteFreqQ8[TRACKER_NOTE_COUNT + 1] = {
+    0, // Rest
+    8372, 8870, 9397, 9956, 10548, 11175, 11840, 12544, 13290, 14080, 14917, 15804, // C1-B1
+    16744, 17740, 18795, 19912, 21096, 22351, 23680, 25088, 26580, 28160, 29834, 31609, // C2-B2
+    33488, 35479, 37589, 39824, 42192, 44701, 47359, 50175, 53159, 56320, 59669, 63217, // C3-B3
+    66976, 70959, 75178, 79649, 84385, 89402, 94719, 100351, 106318, 112640, 119338, 126434, // C4-B4
+    133952, 141918, 150356, 159297, 168769, 178805, 189437, 200702, 212636, 225280, 238676, 252868, // C5-B5
+    267905, 283835, 300713, 318594, 337539, 357610, 378874, 401403, 425272, 450560, 477352, 505737, // C6-B6
+    535809, 567670, 601425, 637188, 675077, 715219, 757749, 802807, 850544, 901120, 954703, 1011473, // C7-B7
+    1071618, 1135340, 1202851, 1274376, 1350154, 1430439, 1515497, 1605613, 1701088, 1802240, 1909407, 2022946, // C8-B8
+};
+
+/* API Implementation */
+
+void Tracker_Start(TrackerChannel* ch, const TrackerSong* song, uint8_t channel, uint8_t loop)
+{
+    ch->song = song;
+    ch->order = song->order[channel];
+    ch->loopPoint = ch->order;
+    ch->row = NULL;
+    ch->length = 1;
+    ch->loop = loop;
+}
+
+/* Decodes rows until one that takes time; length changes and pattern
+   boundaries are consumed on the way. Safe to call from interrupt context. */
+uint8_t Tracker_NextRow(TrackerChannel* ch, uint8_t* note, uint8_t* ticks)
+{
+    uint32_t emptyOrders = 0;
+    uint8_t value;
+
+    if (ch->song == NULL)
+    {
+        return 0;
+    }
+
+    for (;;)
+    {
+        if (ch->row == NULL)
+        {
+            if (++emptyOrders > TRACKER_MAX_EMPTY_ORDERS)
+            {
+                ch->song = NULL;
+                return 0;
+            }
+
+            value = *ch->order;
+
+            if (value == TRACKER_ORDER_LOOP)
+            {
+                ch->order++;
+                ch->loopPoint = ch->order;
+                continue;
+            }
+
+            if (value == TRACKER_ORDER_END)
+            {
+                if (!ch->loop)
+                {
+                    ch->song = NULL;
+                    return 0;
+                }
+                ch->order = ch->loopPoint; // Restart BGM Loop
+                continue;
+            }
+
+            ch->row = ch->song->patterns[value];
+            ch->order++;
+        }
+
+        value = *ch->row++;
+
+        if (value == TRACKER_ROW_END)
+        {
+            ch->row = NULL;
+        }
+        else if (value & TRACKER_ROW_LENGTH)
+        {
+            ch->length = (value & 0x3FU) + 1;
+        }
+        else
+        {
+            *note = (value <= TRACKER_NOTE_COUNT) ? value : TRACKER_ROW_REST;
+            *ticks = ch->length;
+            return 1;
+        }
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * PowerManager.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PowerManager.h"
+#include "Trace.h"
+
+extern TIM_HandleTypeDef htim6; // HAL time base, masked while the core sleeps
+
+/* Internal State */
+static TIM_HandleTypeDef htim2;           // 1 MHz free-running, keeps counting through WFI
+static volatile uint32_t lastInputTick;
+static volatile PowerActivity currentActivity = POWER_ACTIVITY_MENU;
+static volatile PowerManager_Stats stats;
+static uint32_t lastStampUs;              // TIM2 at the last totalUs update
+static uint32_t sleepStartUs;
+static uint32_t tim6AtSleepUs;            // TIM6 phase at sleep entry (+1000 if a tick was pending)
+
+/* Helper: Advance totalUs to 'now'. Interrupts must be disabled.
+   TIM2 wraps after ~71 minutes; every sleep and GetStats call folds it in. */
+static void Account_Elapsed(uint32_t now)
+{
+    stats.totalUs += (uint32_t)(now - lastStampUs);
+    lastStampUs = now;
+}
+
+/* API Implementation */
+
+void PowerManager_Init(void)
+{
+    __HAL_RCC_TIM2_CLK_ENABLE();
+
+    htim2.Instance = TIM2;
+    htim2.Init.Prescaler = (2 * HAL_RCC_GetPCLK1Freq() / 1000000U) - 1; // APB1 Timer Clock = 84 MHz -> 1 MHz
+    htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim2.Init.Period = 0xFFFFFFFFU;
+    htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_Base_Init(&htim2) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    HAL_TIM_Base_Start(&htim2);
+
+    lastStampUs = TIM2->CNT;
+    lastInputTick = HAL_GetTick();
+
+    // MCU_ACTIVE is low only while the core is in WFI
+    HAL_GPIO_WritePin(MCU_ACTIVE_GPIO_Port, MCU_ACTIVE_Pin, GPIO_PIN_SET);
+}
+
+void PowerManager_NotifyInput(void)
+{
+    lastInputTick = HAL_GetTick();
+}
+
+void PowerManager_SetActivity(PowerActivity activity)
+{
+    currentActivity = activity;
+}
+
+uint8_t PowerManager_GetFrameInterval(void)
+{
+    switch (currentActivity)
+    {
+        case POWER_ACTIVITY_PLAYING:
+            return 1;
+        case POWER_ACTIVITY_HALTED:
+            return POWER_IDLE_FRAME_INTERVAL;
+        default:
+            return ((HAL_GetTick() - lastInputTick) < POWER_IDLE_TIMEOUT_MS) ? 1 : POWER_IDLE_FRAME_INTERVAL;
+    }
+}
+
+void PowerManager_FrameThrottled(void)
+{
+    stats.framesThrottled++;
+}
+
+void PowerManager_GetStats(PowerManager_Stats* out)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Account_Elapsed(TIM2->CNT);
+    *out = stats;
+    __set_PRIMASK(primask);
+}
+
+uint32_t PowerManager_GetTimeUs(void)
+{
+    return TIM2->CNT;
+}
+
+/* Called by the FreeRTOS port right before WFI */
+void PowerManager_PreSleep(uint32_t* idleTicks)
+{
+    (void)idleTicks; // Sleep is always allowed; SysTick is reprogrammed by the port
+
+    // The 1 kHz HAL tick would wake the core every millisecond
+    HAL_SuspendTick();
+    HAL_GPIO_WritePin(MCU_ACTIVE_GPIO_Port, MCU_ACTIVE_Pin, GPIO_PIN_RESET);
+    sleepStartUs = TIM2->CNT;
+
+    // TIM6 keeps counting (1 MHz, period 999), only its interrupt is off
+    tim6AtSleepUs = TIM6->CNT;
+    if (__HAL_TIM_GET_FLAG(&htim6, TIM_FLAG_UPDATE))
+    {
+        tim6AtSleepUs += 1000U; // Wrapped, tick not serviced yet
+    }
+}
+
+/* Called by the FreeRTOS port right after WFI, before the RTOS tick is stepped */
+void PowerManager_PostSleep(uint32_t idleTicks)
+{
+    uint32_t now = TIM2->CNT;
+    uint32_t slept = now - sleepStartUs;
+
+    (void)idleTicks;
+    HAL_GPIO_WritePin(MCU_ACTIVE_GPIO_Port, MCU_ACTIVE_Pin, GPIO_PIN_SET);
+
+    stats.sleepUs += slept;
+    stats.sleeps++;
+    Account_Elapsed(now);
+    TRACE_EVENT(TRACE_EVT_SLEEP, slept);
+
+    // Credit HAL_GetTick with the TIM6 periods that ended during the sleep,
+    // counted from TIM6's own phase; TIM6 ran on, so its phase is still right
+    uwTick += (tim6AtSleepUs + slept) / 1000U;
+
+    // A pending update was already included in the credit
+    __HAL_TIM_CLEAR_FLAG(&htim6, TIM_FLAG_UPDATE);
+    HAL_ResumeTick();
+}
@@ -0,0 +1,267 @@
+/*
+ * Profiler.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "Profiler.h"
+#include "BootProfile.h"
+#include "SdramTest.h"
+#include "SdramBench.h"
+#include "MemoryMonitor.h"
+#include "GameSnapshot.h"
+#include "CcmRam.h"
+#include "RamFunc.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TRACKED_TASKS (PROFILER_MAX_TASKS + 1) // Task numbers start at 1
+
+/* Internal State */
+static volatile uint32_t switchCount[TRACKED_TASKS] CCM_BSS; // Written by the scheduler only
+static volatile uint32_t switchTotal CCM_BSS;
+static uint32_t lastTaskNumber CCM_BSS;
+
+static Profiler_Report latest;                   // Guarded by a critical section
+static TaskStatus_t taskStatus[PROFILER_MAX_TASKS];
+static uint32_t prevRunTime[TRACKED_TASKS];
+static uint32_t prevSwitches[TRACKED_TASKS];
+static uint32_t prevSwitchTotal;
+static uint32_t prevTotalRunTime;
+
+#if PROFILER_UART_DUMP
+extern UART_HandleTypeDef huart1;
+static char dumpBuffer[96 + PROFILER_MAX_TASKS * 96 + 256 + MEMORY_MAX_TASKS * 80 + 256];
+static MemoryMonitor_Report memoryReport;
+static GameSnapshot gameSnapshot;
+static uint32_t gameReported;
+#endif
+
+/* Helper: Build one report from the kernel's task list */
+static void Profiler_Sample(Profiler_Report* report)
+{
+    uint32_t totalRunTime;
+    uint32_t switches[TRACKED_TASKS];
+    uint32_t total;
+    UBaseType_t count;
+    UBaseType_t i;
+
+    count = uxTaskGetSystemState(taskStatus, PROFILER_MAX_TASKS, &totalRunTime);
+
+    taskENTER_CRITICAL();
+    memcpy(switches, (const void*)switchCount, sizeof(switches));
+    total = switchTotal;
+    taskEXIT_CRITICAL();
+
+    report->windowUs = totalRunTime - prevTotalRunTime;
+    report->switches = total - prevSwitchTotal;
+    report->taskCount = 0;
+    prevTotalRunTime = totalRunTime;
+    prevSwitchTotal = total;
+
+    for (i = 0; i < count; i++)
+    {
+        const TaskStatus_t* status = &taskStatus[i];
+        uint32_t number = status->xTaskNumber;
+        Profiler_TaskInfo info;
+        int slot;
+
+        if (number >= TRACKED_TASKS)
+        {
+            continue;
+        }
+
+        strncpy(info.name, status->pcTaskName, PROFILER_NAME_LEN - 1);
+        info.name[PROFILER_NAME_LEN - 1] = '\0';
+        info.runTimeUs = status->ulRunTimeCounter - prevRunTime[number];
+        info.cpuPermille = (report->windowUs > 0)
+                         ? (uint16_t)(((uint64_t)info.runTimeUs * 1000U) / report->windowUs) : 0;
+        info.priority = (uint8_t)status->uxCurrentPriority;
+        info.state = (uint8_t)status->eCurrentState;
+        info.stackFreeBytes = (uint32_t)status->usStackHighWaterMark * sizeof(StackType_t);
+        info.switches = switches[number] - prevSwitches[number];
+
+        prevRunTime[number] = status->ulRunTimeCounter;
+        prevSwitches[number] = switches[number];
+
+        // Insertion sort, busiest task first
+        slot = report->taskCount++;
+        while (slot > 0 && report->tasks[slot - 1].cpuPermille < info.cpuPermille)
+        {
+            report->tasks[slot] = report->tasks[slot - 1];
+            slot--;
+        }
+        report->tasks[slot] = info;
+    }
+}
+
+/* API Implementation */
+
+void ProfilerTask(void *argument)
+{
+    static Profiler_Report report;
+    uint32_t sequence = 0;
+#if PROFILER_UART_DUMP
+    uint32_t memoryWindows = 0;
+    uint8_t bootReported = 0;
+#endif
+
+#if PROFILER_UART_DUMP && RAMFUNC_BENCHMARK
+    // Flash vs RAM execution, once, before the first window
+    {
+        static RamFunc_Report ramFuncReport;
+        int length;
+
+        RamFunc_Benchmark(&ramFuncReport);
+        length = RamFunc_Format(&ramFuncReport, dumpBuffer, sizeof(dumpBuffer));
+        if (length > 0 && huart1.gState == HAL_UART_STATE_READY)
+        {
+            HAL_UART_Transmit_IT(&huart1, (uint8_t*)dumpBuffer, (uint16_t)length);
+        }
+    }
+#endif
+
+    // First window starts now, not at boot
+    Profiler_Sample(&report);
+
+    for(;;)
+    {
+        osDelay(PROFILER_PERIOD_MS);
+
+        Profiler_Sample(&report);
+        report.sequence = ++sequence;
+
+        taskENTER_CRITICAL();
+        latest = report;
+        taskEXIT_CRITICAL();
+
+        MemoryMonitor_Update();
+
+#if PROFILER_UART_DUMP
+        // Boot timeline, once the first frame is up; it takes this window's slot
+        if (!bootReported && BootProfile_IsComplete() && huart1.gState == HAL_UART_STATE_READY)
+        {
+            static BootProfile_Report bootReport;
+            static SdramTest_Report sdramReport;
+            static SdramBench_Report benchReport;
+            int length;
+
+            BootProfile_GetReport(&bootReport);
+            length = BootProfile_Format(&bootReport, dumpBuffer, sizeof(dumpBuffer));
+            if (length > 0)
+            {
+                int extra;
+                SdramTest_GetReport(&sdramReport);
+                extra = SdramTest_Format(&sdramReport, dumpBuffer + length, sizeof(dumpBuffer) - length);
+                if (extra > 0)
+                {
+                    length += extra;
+                }
+                SdramBench_GetReport(&benchReport);
+                extra = SdramBench_Format(&benchReport, dumpBuffer + length, sizeof(dumpBuffer) - length);
+                if (extra > 0)
+                {
+                    length += extra;
+                }
+            }
+            if (length > 0)
+            {
+                HAL_UART_Transmit_IT(&huart1, (uint8_t*)dumpBuffer, (uint16_t)length);
+            }
+            bootReported = 1;
+        }
+
+        // Interrupt driven so the dump does not show up as busy time; a
+        // window is skipped if the previous line is still being sent
+        if (huart1.gState == HAL_UART_STATE_READY)
+        {
+            int length = Profiler_Format(&report, dumpBuffer, sizeof(dumpBuffer));
+
+            // Stack/heap sizing report rides along every MEMORY_REPORT_PERIOD_MS
+            if (length > 0 && ++memoryWindows >= MEMORY_REPORT_PERIOD_MS / PROFILER_PERIOD_MS)
+            {
+                int extra;
+                MemoryMonitor_GetReport(&memoryReport);
+                extra = MemoryMonitor_Format(&memoryReport, dumpBuffer + length, sizeof(dumpBuffer) - length);
+                if (extra > 0)
+                {
+                    length += extra;
+                    memoryWindows = 0;
+                }
+            }
+
+            // Game state as another task sees it (lock-free snapshot), when it changed
+            if (length > 0 && GameSnapshot_Read(&gameSnapshot) != gameReported)
+            {
+                int extra = GameSnapshot_Format(&gameSnapshot, dumpBuffer + length, sizeof(dumpBuffer) - length);
+                if (extra > 0)
+                {
+                    length += extra;
+                    gameReported = gameSnapshot.sequence;
+                }
+            }
+
+            if (length > 0)
+            {
+                HAL_UART_Transmit_IT(&huart1, (uint8_t*)dumpBuffer, (uint16_t)length);
+            }
+        }
+#endif
+    }
+}
+
+uint32_t Profiler_GetReport(Profiler_Report* report)
+{
+    taskENTER_CRITICAL();
+    *report = latest;
+    taskEXIT_CRITICAL();
+    return report->sequence;
+}
+
+/* {"seq":1,"window_us":1000012,"switches":843,"tasks":[{"name":"GUI_Task",
+   "cpu":41.2,"prio":24,"state":2,"stack_free":30712,"switches":60},...]} */
+int Profiler_Format(const Profiler_Report* report, char* buffer, uint32_t size)
+{
+    uint32_t used;
+    int n;
+    uint8_t i;
+
+    n = snprintf(buffer, size, "{\"seq\":%lu,\"window_us\":%lu,\"switches\":%lu,\"tasks\":[",
+                 (unsigned long)report->sequence, (unsigned long)report->windowUs,
+                 (unsigned long)report->switches);
+    if (n < 0 || (uint32_t)n >= size) return -1;
+    used = n;
+
+    for (i = 0; i < report->taskCount; i++)
+    {
+        const Profiler_TaskInfo* t = &report->tasks[i];
+        n = snprintf(buffer + used, size - used,
+                     "%s{\"name\":\"%s\",\"cpu\":%u.%u,\"prio\":%u,\"state\":%u,\"stack_free\":%lu,\"switches\":%lu}",
+                     (i > 0) ? "," : "", t->name, t->cpuPermille / 10, t->cpuPermille % 10,
+                     t->priority, t->state, (unsigned long)t->stackFreeBytes, (unsigned long)t->switches);
+        if (n < 0 || (uint32_t)n >= size - used) return -1;
+        used += n;
+    }
+
+    n = snprintf(buffer + used, size - used, "]}\r\n");
+    if (n < 0 || (uint32_t)n >= size - used) return -1;
+    return used + n;
+}
+
+void Profiler_TaskSwitchedIn(uint32_t taskNumber)
+{
+    if (taskNumber == lastTaskNumber)
+    {
+        return; // Same task selected again, not a switch
+    }
+    lastTaskNumber = taskNumber;
+    switchTotal++;
+
+    if (taskNumber < TRACKED_TASKS)
+    {
+        switchCount[taskNumber]++;
+    }
+}
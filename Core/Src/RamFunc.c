@@ -0,0 +1,192 @@
+/*
+ * RamFunc.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "RamFunc.h"
+#include "main.h"
+#include <stdio.h>
+
+#define GRID_ROWS       20
+#define GRID_COLS       10
+#define MIX_PAIRS       64      // One mixer chunk
+#define BENCH_IN_RAM    __attribute__((section(".RamFunc"), noinline)) // Regardless of RAMFUNC_ENABLED
+#define BENCH_IN_FLASH  __attribute__((noinline))
+#define KERNEL          static inline __attribute__((always_inline))
+
+typedef uint32_t (*Bench_Fn)(uint32_t seed);
+
+/* Internal State */
+static signed char grid[GRID_ROWS][GRID_COLS]; // -1 = empty, as in Model
+static uint32_t mix[MIX_PAIRS];
+static volatile uint32_t sink;                 // Keeps results alive
+
+/* L piece, per rotation, laid out like Tetris::SHAPES */
+static const uint8_t pieceShape[4][4][4] = {
+    { {0, 0, 1, 0}, {1, 1, 1, 0}, {0, 0, 0, 0}, {0, 0, 0, 0} },
+    { {0, 1, 0, 0}, {0, 1, 0, 0}, {0, 1, 1, 0}, {0, 0, 0, 0} },
+    { {0, 0, 0, 0}, {1, 1, 1, 0}, {1, 0, 0, 0}, {0, 0, 0, 0} },
+    { {1, 1, 0, 0}, {0, 1, 0, 0}, {0, 1, 0, 0}, {0, 0, 0, 0} },
+};
+
+/* Kernel: Model::isCollision for every column and rotation on half the rows */
+KERNEL uint32_t Collision_Kernel(uint32_t seed)
+{
+    uint32_t hits = 0;
+    int x, y, r;
+
+    for (y = (int)(seed & 1U); y < GRID_ROWS; y += 2)
+    {
+        for (x = -1; x < GRID_COLS; x++)
+        {
+            for (r = 0; r < 4; r++)
+            {
+                int row, col, hit = 0;
+                for (row = 0; row < 4 && !hit; row++)
+                {
+                    for (col = 0; col < 4; col++)
+                    {
+                        if (pieceShape[r][row][col])
+                        {
+                            int gridX = x + col;
+                            int gridY = y + row;
+                            if (gridX < 0 || gridX >= GRID_COLS || gridY >= GRID_ROWS ||
+                                (gridY >= 0 && grid[gridY][gridX] != -1))
+                            {
+                                hit = 1;
+                                break;
+                            }
+                        }
+                    }
+                }
+                hits += hit;
+            }
+        }
+    }
+    return hits;
+}
+
+/* Kernel: the mixer's square wave voice for one chunk */
+KERNEL uint32_t Mix_Kernel(uint32_t seed)
+{
+    uint32_t phase = seed;
+    uint32_t inc = 0x0147AE14U; // ~440 Hz at 22.05 kHz
+    int32_t amp = 4096;
+    uint32_t i;
+
+    for (i = 0; i < MIX_PAIRS; i++)
+    {
+        int32_t s0, s1;
+        phase += inc; s0 = ((int32_t)phase < 0) ? -amp : amp;
+        phase += inc; s1 = ((int32_t)phase < 0) ? -amp : amp;
+        mix[i] = __QADD16(mix[i], __PKHBT(s0, s1, 16));
+    }
+    return phase;
+}
+
+/* The same kernels, compiled once for each place */
+BENCH_IN_FLASH static uint32_t Collision_Flash(uint32_t seed) { return Collision_Kernel(seed); }
+BENCH_IN_RAM   static uint32_t Collision_Ram(uint32_t seed)   { return Collision_Kernel(seed); }
+BENCH_IN_FLASH static uint32_t Mix_Flash(uint32_t seed)       { return Mix_Kernel(seed); }
+BENCH_IN_RAM   static uint32_t Mix_Ram(uint32_t seed)         { return Mix_Kernel(seed); }
+
+/* Helper: Empty the ART instruction and data caches (they must be off to reset) */
+static void Flush_ART(void)
+{
+    __HAL_FLASH_INSTRUCTION_CACHE_DISABLE();
+    __HAL_FLASH_DATA_CACHE_DISABLE();
+    __HAL_FLASH_INSTRUCTION_CACHE_RESET();
+    __HAL_FLASH_DATA_CACHE_RESET();
+    __HAL_FLASH_INSTRUCTION_CACHE_ENABLE();
+    __HAL_FLASH_DATA_CACHE_ENABLE();
+}
+
+/* Helper: Average cycles per call over RAMFUNC_BENCH_RUNS calls */
+static uint32_t Measure(Bench_Fn fn, uint8_t cold)
+{
+    uint64_t total = 0;
+    uint32_t run;
+
+    fn(0); // Warm up (fills the ART cache for the warm flash case)
+
+    for (run = 0; run < RAMFUNC_BENCH_RUNS; run++)
+    {
+        uint32_t primask = __get_PRIMASK();
+        uint32_t start;
+
+        __disable_irq();
+        if (cold)
+        {
+            Flush_ART();
+        }
+        start = DWT->CYCCNT;
+        sink = fn(run);
+        total += DWT->CYCCNT - start;
+        __set_PRIMASK(primask);
+    }
+    return (uint32_t)(total / RAMFUNC_BENCH_RUNS);
+}
+
+/* Helper: Run one kernel in both places, warm and cold */
+static void Bench_Kernel(RamFunc_Result* result, const char* name, Bench_Fn inFlash, Bench_Fn inRam)
+{
+    result->name = name;
+    result->flashCycles = Measure(inFlash, 0);
+    result->flashColdCycles = Measure(inFlash, 1);
+    result->ramCycles = Measure(inRam, 0);
+    result->ramColdCycles = Measure(inRam, 1);
+}
+
+/* API Implementation */
+
+void RamFunc_Benchmark(RamFunc_Report* report)
+{
+    uint32_t i;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* A half-filled board: every other cell of the bottom rows taken */
+    for (i = 0; i < GRID_ROWS * GRID_COLS; i++)
+    {
+        grid[i / GRID_COLS][i % GRID_COLS] = (i >= GRID_COLS * 12 && (i & 1U)) ? 1 : -1;
+    }
+    for (i = 0; i < MIX_PAIRS; i++)
+    {
+        mix[i] = 0;
+    }
+
+    report->count = 0;
+    Bench_Kernel(&report->results[report->count++], "collision", Collision_Flash, Collision_Ram);
+    Bench_Kernel(&report->results[report->count++], "mix", Mix_Flash, Mix_Ram);
+}
+
+/* {"ramfunc":{"collision":{"flash":9120,"flash_cold":9870,"ram":9644,
+   "ram_cold":9644},"mix":{...}}} */
+int RamFunc_Format(const RamFunc_Report* report, char* buffer, uint32_t size)
+{
+    uint32_t used;
+    int n;
+    uint8_t i;
+
+    n = snprintf(buffer, size, "{\"ramfunc\":{");
+    if (n < 0 || (uint32_t)n >= size) return -1;
+    used = n;
+
+    for (i = 0; i < report->count; i++)
+    {
+        const RamFunc_Result* r = &report->results[i];
+        n = snprintf(buffer + used, size - used,
+                     "%s\"%s\":{\"flash\":%lu,\"flash_cold\":%lu,\"ram\":%lu,\"ram_cold\":%lu}",
+                     (i > 0) ? "," : "", r->name,
+                     (unsigned long)r->flashCycles, (unsigned long)r->flashColdCycles,
+                     (unsigned long)r->ramCycles, (unsigned long)r->ramColdCycles);
+        if (n < 0 || (uint32_t)n >= size - used) return -1;
+        used += n;
+    }
+
+    n = snprintf(buffer + used, size - used, "}}\r\n");
+    if (n < 0 || (uint32_t)n >= size - used) return -1;
+    return used + n;
+}
@@ -0,0 +1,296 @@
+/*
+ * SdramBench.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "SdramBench.h"
+#include "stm32f4xx_hal.h"
+#include <stdio.h>
+
+#define PIXELS         (SDRAMBENCH_WIDTH * SDRAMBENCH_HEIGHT)
+#define DMA2D_IFCR_ALL (DMA2D_IFCR_CTEIF | DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTWIF | \
+                        DMA2D_IFCR_CAECIF | DMA2D_IFCR_CCTCIF | DMA2D_IFCR_CCEIF)
+#define BLEND_ALPHA    0x80U
+
+/* Framebuffer section start (STM32F429XX_FLASH.ld), scanned for the LTDC runs */
+extern uint32_t _sframebuffer;
+
+static const char* const testNames[SDRAMBENCH_COUNT] = {
+    "cpu_read", "cpu_write", "cpu_col_read", "cpu_col_write",
+    "fill565", "copy565", "blend565", "fill8888", "copy8888", "blend8888"
+};
+
+/* Internal State: two ARGB8888 screens in external SDRAM (section placed by
+   STM32F429XX_FLASH.ld, contents are don't-care) */
+static uint32_t benchSrc[PIXELS] __attribute__((section("SdramBench")));
+static uint32_t benchDst[PIXELS] __attribute__((section("SdramBench")));
+static volatile uint32_t sink;
+static SdramBench_Report report;
+
+/* Helper: Start the configured DMA2D transfer and poll it. Returns the cycles taken, 0 on error */
+static uint32_t Dma2d_Run(void)
+{
+    uint32_t start;
+    uint32_t isr;
+
+    DMA2D->IFCR = DMA2D_IFCR_ALL;
+    start = DWT->CYCCNT;
+    DMA2D->CR |= DMA2D_CR_START;
+    do {
+        isr = DMA2D->ISR;
+    } while (!(isr & (DMA2D_ISR_TCIF | DMA2D_ISR_TEIF | DMA2D_ISR_CEIF)));
+    start = DWT->CYCCNT - start;
+
+    DMA2D->IFCR = DMA2D_IFCR_ALL;
+    return (isr & DMA2D_ISR_TCIF) ? start : 0;
+}
+
+/* Helper: One pass of a test, returns cycles (0 = failed) and the bytes it moved */
+static uint32_t Run_Once(SdramBench_Test test, uint32_t* bytes)
+{
+    volatile uint32_t* src = benchSrc;
+    volatile uint32_t* dst = benchDst;
+    uint32_t format = DMA2D_OUTPUT_ARGB8888;
+    uint32_t bpp = 4;
+    uint32_t start = DWT->CYCCNT;
+    uint32_t sum = 0;
+    uint32_t x, y, i;
+
+    switch (test)
+    {
+    case SDRAMBENCH_CPU_READ:
+        for (i = 0; i < PIXELS; i++) sum += src[i];
+        break;
+    case SDRAMBENCH_CPU_WRITE:
+        for (i = 0; i < PIXELS; i++) dst[i] = i;
+        break;
+    case SDRAMBENCH_CPU_COLUMN_READ:
+        for (x = 0; x < SDRAMBENCH_WIDTH; x++)
+            for (y = 0; y < SDRAMBENCH_HEIGHT; y++) sum += src[y * SDRAMBENCH_WIDTH + x];
+        break;
+    case SDRAMBENCH_CPU_COLUMN_WRITE:
+        for (x = 0; x < SDRAMBENCH_WIDTH; x++)
+            for (y = 0; y < SDRAMBENCH_HEIGHT; y++) dst[y * SDRAMBENCH_WIDTH + x] = x;
+        break;
+    default:
+        break;
+    }
+    if (test <= SDRAMBENCH_CPU_COLUMN_WRITE)
+    {
+        sink = sum;
+        *bytes = PIXELS * 4U;
+        return DWT->CYCCNT - start;
+    }
+
+    if (test <= SDRAMBENCH_BLEND_RGB565)
+    {
+        format = DMA2D_OUTPUT_RGB565;
+        bpp = 2;
+    }
+    *bytes = PIXELS * bpp;
+
+    /* DMA2D_INPUT_* and DMA2D_OUTPUT_* share their codes for these formats */
+    DMA2D->OPFCCR = format;
+    DMA2D->OMAR = (uint32_t)benchDst;
+    DMA2D->OOR = 0;
+    DMA2D->NLR = (SDRAMBENCH_WIDTH << DMA2D_NLR_PL_Pos) | SDRAMBENCH_HEIGHT;
+
+    switch (test)
+    {
+    case SDRAMBENCH_FILL_RGB565:
+    case SDRAMBENCH_FILL_ARGB8888:
+        DMA2D->CR = DMA2D_R2M;
+        DMA2D->OCOLR = 0x5A5A5A5AU;
+        break;
+    case SDRAMBENCH_COPY_RGB565:
+    case SDRAMBENCH_COPY_ARGB8888:
+        DMA2D->CR = DMA2D_M2M;
+        DMA2D->FGMAR = (uint32_t)benchSrc;
+        DMA2D->FGOR = 0;
+        DMA2D->FGPFCCR = format;
+        break;
+    default: // Blend the source over the destination, in place
+        DMA2D->CR = DMA2D_M2M_BLEND;
+        DMA2D->FGMAR = (uint32_t)benchSrc;
+        DMA2D->FGOR = 0;
+        DMA2D->FGPFCCR = format | (DMA2D_REPLACE_ALPHA << DMA2D_FGPFCCR_AM_Pos) | (BLEND_ALPHA << DMA2D_FGPFCCR_ALPHA_Pos);
+        DMA2D->BGMAR = (uint32_t)benchDst;
+        DMA2D->BGOR = 0;
+        DMA2D->BGPFCCR = format;
+        break;
+    }
+    return Dma2d_Run();
+}
+
+/* Helper: Average rate of a test over SDRAMBENCH_RUNS passes */
+static uint32_t Measure(SdramBench_Test test)
+{
+    uint64_t cycles = 0;
+    uint32_t bytes = 0;
+    uint32_t run;
+
+    for (run = 0; run < SDRAMBENCH_RUNS; run++)
+    {
+        uint32_t c = Run_Once(test, &bytes);
+        if (c == 0)
+        {
+            return 0;
+        }
+        cycles += c;
+    }
+    return (uint32_t)(((uint64_t)bytes * SDRAMBENCH_RUNS * SystemCoreClock) / (cycles * 1000000U));
+}
+
+/* API Implementation */
+
+void SdramBench_Run(void)
+{
+    uint32_t layerAddress = LTDC_Layer1->CFBAR;
+    uint8_t i;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* LTDC off: only the benchmark on the SDRAM */
+    LTDC->GCR &= ~LTDC_GCR_LTDCEN;
+    for (i = 0; i < SDRAMBENCH_COUNT; i++)
+    {
+        report.mbpsLtdcOff[i] = Measure((SdramBench_Test)i);
+    }
+
+    /* LTDC on, scanning the (cleared) framebuffer as it will during the game */
+    LTDC_Layer1->CFBAR = (uint32_t)&_sframebuffer;
+    LTDC->SRCR = LTDC_SRCR_IMR;
+    LTDC->GCR |= LTDC_GCR_LTDCEN;
+    for (i = 0; i < SDRAMBENCH_COUNT; i++)
+    {
+        report.mbpsLtdcOn[i] = Measure((SdramBench_Test)i);
+    }
+
+    LTDC_Layer1->CFBAR = layerAddress;
+    LTDC->SRCR = LTDC_SRCR_IMR;
+    report.valid = 1;
+}
+
+uint32_t SdramBench_BlitCycles(const void* pixels, const uint32_t* clut, uint16_t clutSize,
+                               uint16_t width, uint16_t height)
+{
+    uint64_t cycles = 0;
+    uint32_t run;
+
+    for (run = 0; run < SDRAMBENCH_RUNS; run++)
+    {
+        uint32_t start = DWT->CYCCNT;
+        uint32_t c;
+
+        /* As STM32DMA does it: L8 reloads its CLUT before every blit */
+        if (clut != 0)
+        {
+            DMA2D->FGCMAR = (uint32_t)clut;
+            DMA2D->FGPFCCR = DMA2D_INPUT_L8 | (DMA2D_COMBINE_ALPHA << DMA2D_FGPFCCR_AM_Pos) | (0xFFU << DMA2D_FGPFCCR_ALPHA_Pos)
+                           | ((uint32_t)(clutSize - 1U) << DMA2D_FGPFCCR_CS_Pos) | (DMA2D_CCM_ARGB8888 << DMA2D_FGPFCCR_CCM_Pos);
+            DMA2D->FGPFCCR |= DMA2D_FGPFCCR_START;
+            while (DMA2D->FGPFCCR & DMA2D_FGPFCCR_START) {}
+        }
+        else
+        {
+            DMA2D->FGPFCCR = DMA2D_INPUT_ARGB8888 | (DMA2D_COMBINE_ALPHA << DMA2D_FGPFCCR_AM_Pos) | (0xFFU << DMA2D_FGPFCCR_ALPHA_Pos);
+        }
+        start = DWT->CYCCNT - start;
+
+        DMA2D->FGMAR = (uint32_t)pixels;
+        DMA2D->FGOR = 0;
+        DMA2D->BGMAR = (uint32_t)benchDst;
+        DMA2D->BGOR = SDRAMBENCH_WIDTH - width;
+        DMA2D->BGPFCCR = DMA2D_INPUT_RGB565;
+        DMA2D->OMAR = (uint32_t)benchDst;
+        DMA2D->OOR = SDRAMBENCH_WIDTH - width;
+        DMA2D->OPFCCR = DMA2D_OUTPUT_RGB565;
+        DMA2D->NLR = ((uint32_t)width << DMA2D_NLR_PL_Pos) | height;
+        DMA2D->CR = DMA2D_M2M_BLEND;
+
+        c = Dma2d_Run();
+        if (c == 0)
+        {
+            return 0;
+        }
+        cycles += start + c;
+    }
+    return (uint32_t)(cycles / SDRAMBENCH_RUNS);
+}
+
+void SdramBench_SetAtlas(uint8_t bitmaps, uint32_t bytes, uint32_t flashCycles, uint32_t sdramCycles)
+{
+    report.atlasBitmaps = bitmaps;
+    report.atlasBytes = bytes;
+    report.atlasFlashCycles = flashCycles;
+    report.atlasSdramCycles = sdramCycles;
+}
+
+void SdramBench_GetReport(SdramBench_Report* out)
+{
+    *out = report;
+}
+
+/* Helper: {"cpu_read":61,...} */
+static int Format_Set(const uint32_t* mbps, char* buffer, uint32_t size)
+{
+    uint32_t used = 0;
+    int n;
+    uint8_t i;
+
+    for (i = 0; i < SDRAMBENCH_COUNT; i++)
+    {
+        n = snprintf(buffer + used, size - used, "%c\"%s\":%lu",
+                     (i > 0) ? ',' : '{', testNames[i], (unsigned long)mbps[i]);
+        if (n < 0 || (uint32_t)n >= size - used) return -1;
+        used += n;
+    }
+    n = snprintf(buffer + used, size - used, "}");
+    if (n < 0 || (uint32_t)n >= size - used) return -1;
+    return used + n;
+}
+
+/* {"atlas":{"bitmaps":11,"bytes":39432,"flash_cycles":52210,"sdram_cycles":48876}}
+   {"sdram_bench":{"ltdc_off":{"cpu_read":61,...,"blend8888":98},"ltdc_on":{...}}}
+   in MB/s; each line only if that part ran */
+int SdramBench_Format(const SdramBench_Report* r, char* buffer, uint32_t size)
+{
+    uint32_t used = 0;
+    int n;
+
+    if (r->atlasBitmaps > 0)
+    {
+        n = snprintf(buffer, size, "{\"atlas\":{\"bitmaps\":%u,\"bytes\":%lu,\"flash_cycles\":%lu,\"sdram_cycles\":%lu}}\r\n",
+                     r->atlasBitmaps, (unsigned long)r->atlasBytes,
+                     (unsigned long)r->atlasFlashCycles, (unsigned long)r->atlasSdramCycles);
+        if (n < 0 || (uint32_t)n >= size) return -1;
+        used = n;
+    }
+
+    if (!r->valid)
+    {
+        return used;
+    }
+
+    n = snprintf(buffer + used, size - used, "{\"sdram_bench\":{\"ltdc_off\":");
+    if (n < 0 || (uint32_t)n >= size - used) return -1;
+    used += n;
+
+    n = Format_Set(r->mbpsLtdcOff, buffer + used, size - used);
+    if (n < 0) return -1;
+    used += n;
+
+    n = snprintf(buffer + used, size - used, ",\"ltdc_on\":");
+    if (n < 0 || (uint32_t)n >= size - used) return -1;
+    used += n;
+
+    n = Format_Set(r->mbpsLtdcOn, buffer + used, size - used);
+    if (n < 0) return -1;
+    used += n;
+
+    n = snprintf(buffer + used, size - used, "}}\r\n");
+    if (n < 0 || (uint32_t)n >= size - used) return -1;
+    return used + n;
+}
@@ -0,0 +1,145 @@
+/*
+ * SdramTest.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "SdramTest.h"
+#include "stm32f4xx_hal.h"
+#include <stdio.h>
+
+/* Framebuffer section bounds (STM32F429XX_FLASH.ld) */
+extern uint32_t _sframebuffer;
+extern uint32_t _eframebuffer;
+
+#define DMA2D_IFCR_ALL  (DMA2D_IFCR_CTEIF | DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTWIF | \
+                         DMA2D_IFCR_CAECIF | DMA2D_IFCR_CCTCIF | DMA2D_IFCR_CCEIF)
+
+/* Internal State */
+static SdramTest_Report report;
+
+/* Helper: Bytes over cycles, as MB/s */
+static uint32_t To_MBps(uint32_t bytes, uint32_t cycles)
+{
+    return (cycles > 0) ? (uint32_t)(((uint64_t)bytes * SystemCoreClock) / ((uint64_t)cycles * 1000000U)) : 0;
+}
+
+/* Helper: DMA2D register-to-memory fill, polled (its interrupt is not
+   enabled until TouchGFX starts). Returns the cycles taken, 0 on error */
+static uint32_t Dma2d_Fill(uint32_t address, uint32_t color, uint32_t format,
+                           uint32_t width, uint32_t lines)
+{
+    uint32_t start;
+    uint32_t isr;
+
+    DMA2D->CR = DMA2D_R2M;
+    DMA2D->OPFCCR = format;
+    DMA2D->OCOLR = color;
+    DMA2D->OMAR = address;
+    DMA2D->OOR = 0;
+    DMA2D->NLR = (width << DMA2D_NLR_PL_Pos) | lines;
+    DMA2D->IFCR = DMA2D_IFCR_ALL;
+
+    start = DWT->CYCCNT;
+    DMA2D->CR |= DMA2D_CR_START;
+    do {
+        isr = DMA2D->ISR;
+    } while (!(isr & (DMA2D_ISR_TCIF | DMA2D_ISR_TEIF | DMA2D_ISR_CEIF)));
+    start = DWT->CYCCNT - start;
+
+    DMA2D->IFCR = DMA2D_IFCR_ALL;
+    return (isr & DMA2D_ISR_TCIF) ? start : 0;
+}
+
+/* Helper: Count a word that read back wrong */
+static void Record_Error(volatile uint32_t* word)
+{
+    if (report.errors++ == 0)
+    {
+        report.firstError = (uint32_t)word;
+    }
+}
+
+/* API Implementation */
+
+uint8_t SdramTest_March(void)
+{
+    volatile uint32_t* const base = (volatile uint32_t*)SDRAMTEST_BASE;
+    const uint32_t words = SDRAMTEST_SIZE / 4U;
+    const uint32_t p0 = SDRAMTEST_PATTERN;
+    const uint32_t p1 = ~SDRAMTEST_PATTERN;
+    uint32_t cycles;
+    uint32_t i;
+
+    __HAL_RCC_DMA2D_CLK_ENABLE(); // Runs before MX_DMA2D_Init
+
+    report.marchRun = 1;
+    report.errors = 0;
+    report.firstError = 0;
+
+    /* March X: {(w0); up(r0,w1); down(r1,w0); (r0)}. The write-only element
+       is a DMA2D fill in 8 KB lines; the read elements need the CPU */
+    cycles = Dma2d_Fill(SDRAMTEST_BASE, p0, DMA2D_OUTPUT_ARGB8888,
+                        SDRAMTEST_LINE_BYTES / 4U, SDRAMTEST_SIZE / SDRAMTEST_LINE_BYTES);
+    if (cycles == 0)
+    {
+        report.errors++; // DMA2D transfer error: nothing was written
+        return 0;
+    }
+    report.fillMBps = To_MBps(SDRAMTEST_SIZE, cycles);
+
+    cycles = DWT->CYCCNT;
+    for (i = 0; i < words; i++)
+    {
+        if (base[i] != p0) Record_Error(&base[i]);
+        base[i] = p1;
+    }
+    report.readWriteMBps = To_MBps(SDRAMTEST_SIZE, DWT->CYCCNT - cycles);
+
+    for (i = words; i-- > 0; )
+    {
+        if (base[i] != p1) Record_Error(&base[i]);
+        base[i] = p0;
+    }
+
+    cycles = DWT->CYCCNT;
+    for (i = 0; i < words; i++)
+    {
+        if (base[i] != p0) Record_Error(&base[i]);
+    }
+    report.readMBps = To_MBps(SDRAMTEST_SIZE, DWT->CYCCNT - cycles);
+
+    return report.errors == 0;
+}
+
+void SdramTest_ClearFramebuffers(void)
+{
+    uint32_t bytes = (uint32_t)&_eframebuffer - (uint32_t)&_sframebuffer;
+    uint32_t cycles;
+
+    /* Both buffers are contiguous: one fill, 2 x 320 lines */
+    cycles = Dma2d_Fill((uint32_t)&_sframebuffer, SDRAMTEST_CLEAR_COLOR, DMA2D_OUTPUT_RGB565,
+                        SDRAMTEST_FB_WIDTH, bytes / (SDRAMTEST_FB_WIDTH * 2U));
+    report.clearUs = (uint32_t)(((uint64_t)cycles * 1000000U) / SystemCoreClock);
+    report.clearMBps = To_MBps(bytes, cycles);
+}
+
+void SdramTest_GetReport(SdramTest_Report* out)
+{
+    *out = report;
+}
+
+/* {"sdram":{"march":1,"errors":0,"first_error":0,"fill_mb_s":330,
+   "read_mb_s":61,"rw_mb_s":38,"clear_us":1020,"clear_mb_s":301}}; march 0 = skipped */
+int SdramTest_Format(const SdramTest_Report* r, char* buffer, uint32_t size)
+{
+    int n = snprintf(buffer, size,
+                     "{\"sdram\":{\"march\":%u,\"errors\":%lu,\"first_error\":%lu,\"fill_mb_s\":%lu,"
+                     "\"read_mb_s\":%lu,\"rw_mb_s\":%lu,\"clear_us\":%lu,\"clear_mb_s\":%lu}}\r\n",
+                     r->marchRun, (unsigned long)r->errors, (unsigned long)r->firstError,
+                     (unsigned long)r->fillMBps, (unsigned long)r->readMBps,
+                     (unsigned long)r->readWriteMBps, (unsigned long)r->clearUs,
+                     (unsigned long)r->clearMBps);
+    if (n < 0 || (uint32_t)n >= size) return -1;
+    return n;
+}
@@ -6,96 +6,93 @@
  */
 
 #include "SoundEngine.h"
-#include "stm32f4xx_hal.h"
-#include <string.h> // For memset
-
-/* External PWM Timer Handle */
-extern TIM_HandleTypeDef htim10;
+#include "AudioMixer.h"
+#include "MusicData.h" // Songs generated by tools/music_convert.py
+
+/* Command Channel
+ * Each TrackID owns one bit in pendingTracks. Posting ORs the bit in with
+ * LDREX/STREX, so PlayTrack never blocks and works from any task or ISR;
+ * a request whose bit is already set is merged. BGM requests (including
+ * stop) replace each other, so only the newest survives. */
+#define SOUND_FLAG_COMMAND  0x0001U
+#define TRACK_BIT(track)    (1UL << (track))
+#define BGM_TRACKS          (TRACK_BIT(TRACK_NONE) | TRACK_BIT(TRACK_MENU) | TRACK_BIT(TRACK_GAME_THEME_A))
 
 /* Internal State */
-static osMessageQueueId_t soundQueueHandle;
 static osThreadId_t soundTaskHandle;
-static uint8_t volume_percent = 50; // Default volume (0-100)
-
-/* Note Frequencies (Hz) */
-#define NOTE_REST 0
-#define NOTE_C4 262
-#define NOTE_D4 294
-#define NOTE_E4 330
-#define NOTE_F4 349
-#define NOTE_G4 392
-#define NOTE_A4 440
-#define NOTE_B4 494
-#define NOTE_C5 523
-#define NOTE_D5 587
-#define NOTE_E5 659
-#define NOTE_F5 698
-#define NOTE_G5 784
-#define NOTE_A5 880
-#define NOTE_B5 988
-#define NOTE_C6 1047
-
-/* Melodies */
-
-/* 1. Menu Theme: Simple ambient loop */
-static const MusicNote melody_menu[] = {
-    {NOTE_C5, 300}, {NOTE_E5, 300}, {NOTE_G5, 300}, {NOTE_E5, 300},
-    {NOTE_C5, 300}, {NOTE_G4, 300}, {NOTE_C5, 600},
-    {NOTE_REST, 0} // Terminator
-};
-
-/* 2. Game Theme: Korobeiniki (Tetris A) - Simplified */
-static const MusicNote melody_game[] = {
-    // Phrase 1
-    {NOTE_E5, 400}, {NOTE_B4, 200}, {NOTE_C5, 200}, {NOTE_D5, 400},
-    {NOTE_C5, 200}, {NOTE_B4, 200}, {NOTE_A4, 400}, {NOTE_A4, 200},
-    {NOTE_C5, 200}, {NOTE_E5, 400}, {NOTE_D5, 200}, {NOTE_C5, 200},
-    {NOTE_B4, 600}, {NOTE_C5, 200}, {NOTE_D5, 400}, {NOTE_E5, 400},
-    {NOTE_C5, 400}, {NOTE_A4, 400}, {NOTE_A4, 800},
-    {NOTE_REST, 0} // Terminator
-};
-
-/* 3. Game Over: Sad Jingle */
-static const MusicNote melody_gameover[] = {
-    {NOTE_B4, 300}, {NOTE_F4, 300}, {NOTE_D4, 300}, {NOTE_C4, 800},
-    {NOTE_REST, 0}
-};
-
-/* 4. Line Clear: Victory sound */
-static const MusicNote melody_clear[] = {
-    {NOTE_E5, 100}, {NOTE_A5, 400},
-    {NOTE_REST, 0}
-};
-
-/* Helper: Set PWM Frequency */
-static void SetFrequency(uint32_t freq)
+static volatile uint32_t pendingTracks = 0;
+static volatile SoundEngine_Stats stats;
+
+/* Voice Groups: BGM songs use two square voices, SFX songs a square + the noise voice */
+#define BGM_VOICES 2
+#define SFX_VOICES 2
+
+/* Ducking: BGM keeps its song position under an SFX and fades back afterwards */
+#define DUCK_GAIN        96  // BGM level under a line clear (Q8, ~38%)
+#define DUCK_RAMP_MS     30
+#define RESTORE_RAMP_MS  250
+#define SFX_POLL_MS      20  // Command wait timeout while an SFX plays, to notice its end
+
+/* Helper: Interrupt-safe counter increment */
+static void Counter_Inc(volatile uint32_t* counter)
+{
+    uint32_t value;
+
+    do {
+        value = __LDREXW(counter);
+    } while (__STREXW(value + 1, counter) != 0);
+}
+
+/* Helper: Atomically fetch and clear all pending requests */
+static uint32_t Pending_Take(void)
 {
-    if (freq == 0)
+    uint32_t pending;
+
+    do {
+        pending = __LDREXW(&pendingTracks);
+    } while (__STREXW(0, &pendingTracks) != 0);
+
+    return pending;
+}
+
+/* Helper: SFX ranking, higher wins (game over > line clear) */
+static uint8_t Track_Priority(TrackID track)
+{
+    switch (track)
     {
-        /* Stop PWM (0% Duty Cycle) */
-        __HAL_TIM_SET_COMPARE(&htim10, TIM_CHANNEL_1, 0);
+        case TRACK_GAME_OVER:  return 2;
+        case TRACK_LINE_CLEAR: return 1;
+        default:               return 0;
     }
-    else
+}
+
+/* Helper: Make room for an SFX; game over pauses the music, a line clear ducks it */
+static void BGM_Duck(TrackID sfx)
+{
+    uint32_t k;
+
+    for (k = 0; k < BGM_VOICES; k++)
     {
-        /* Calculate Auto-Reload Register (ARR) value
-         * APB2 Timer Clock = 168 MHz (if properly config per instruction)
-         * Prescaler = 167 -> Timer runs at 1 MHz
-         * Period = (1MHz / Freq) - 1
-         */
-        uint32_t period = (1000000 / freq) - 1;
-        
-        /* Set new period */
-        __HAL_TIM_SET_AUTORELOAD(&htim10, period);
-        
-        /* Set Duty Cycle based on Volume */
-        /* Volume 100 = 50% Duty Cycle (Max loud for Square Wave) */
-        /* Volume 0 = 0% Duty Cycle */
-        uint32_t duty = (period / 2) * volume_percent / 100;
-        
-        __HAL_TIM_SET_COMPARE(&htim10, TIM_CHANNEL_1, duty);
-        
-        /* Ensure Timer is running */
-        HAL_TIM_PWM_Start(&htim10, TIM_CHANNEL_1);
+        if (sfx == TRACK_GAME_OVER)
+        {
+            AudioMixer_PauseVoice((MixerVoice)(MIXER_VOICE_BGM + k), 1, DUCK_RAMP_MS);
+        }
+        else
+        {
+            AudioMixer_SetVoiceGain((MixerVoice)(MIXER_VOICE_BGM + k), DUCK_GAIN, DUCK_RAMP_MS);
+        }
+    }
+}
+
+/* Helper: Fade BGM back in from where it was paused or ducked */
+static void BGM_Restore(uint16_t rampMs)
+{
+    uint32_t k;
+
+    for (k = 0; k < BGM_VOICES; k++)
+    {
+        AudioMixer_PauseVoice((MixerVoice)(MIXER_VOICE_BGM + k), 0, rampMs);
+        AudioMixer_SetVoiceGain((MixerVoice)(MIXER_VOICE_BGM + k), 256, rampMs); // Unity
     }
 }
 
@@ -103,19 +100,40 @@ static void SetFrequency(uint32_t freq)
 
 void SoundEngine_Init(void)
 {
-    /* Queue Creation: Depth 4, uint8_t TrackID */
-    soundQueueHandle = osMessageQueueNew(4, sizeof(TrackID), NULL);
-    
-    /* Task Creation should be handled in freertos.c or main.c, 
+    AudioMixer_Init();
+
+    /* Task Creation should be handled in freertos.c or main.c,
        but we provide the function body here. */
 }
 
 void SoundEngine_PlayTrack(TrackID track)
 {
-    if (soundQueueHandle != NULL)
+    uint32_t bit, sameClass, previous, next;
+
+    if (track >= TRACK_COUNT)
+    {
+        Counter_Inc(&stats.dropped);
+        return;
+    }
+
+    bit = TRACK_BIT(track);
+    sameClass = (bit & BGM_TRACKS) ? BGM_TRACKS : bit;
+
+    do {
+        previous = __LDREXW(&pendingTracks);
+        next = (previous & ~sameClass) | bit;
+    } while (__STREXW(next, &pendingTracks) != 0);
+
+    Counter_Inc(&stats.posted);
+    if (previous & sameClass)
+    {
+        Counter_Inc(&stats.merged);
+    }
+
+    /* Requests posted before the task starts stay pending until it does */
+    if (soundTaskHandle != NULL)
     {
-        /* Send to Queue, dont block if full */
-        osMessageQueuePut(soundQueueHandle, &track, 0, 0);
+        osThreadFlagsSet(soundTaskHandle, SOUND_FLAG_COMMAND);
     }
 }
 
@@ -127,102 +145,88 @@ void SoundEngine_Stop(void)
 
 void SoundEngine_SetVolume(uint8_t volume)
 {
-    if (volume > 100) volume = 100;
-    volume_percent = volume;
+    AudioMixer_SetVolume(volume);
+}
+
+void SoundEngine_GetStats(SoundEngine_Stats* out)
+{
+    *out = stats;
 }
 
 /* FreeRTOS Task */
+/* Samples are rendered and songs decoded by the mixer's DMA interrupt; BGM
+   and SFX sit on separate voices, so the task only routes track requests
+   and ducks the music around SFX. It never sleeps without watching the
+   command channel. */
 void SoundEngineTask(void *argument)
 {
-    TrackID currentRequest;
-    TrackID currentTrack = TRACK_NONE;
-    TrackID activeBGM = TRACK_NONE;
-    const MusicNote* currentMelody = NULL;
-    uint32_t noteIndex = 0;
-    
-    /* Ensure hardware initialized */
-    HAL_TIM_PWM_Start(&htim10, TIM_CHANNEL_1);
-    
+    TrackID activeSFX = TRACK_NONE;
+    TrackID sfx;
+    uint32_t pending;
+
+    soundTaskHandle = osThreadGetId();
+
     for(;;)
     {
-        /* Check for new track request */
-        /* If playing, wait 0. If stopped, wait forever (suspend) */
-        uint32_t waitTime = (currentMelody == NULL) ? osWaitForever : 0;
-        
-        if (osMessageQueueGet(soundQueueHandle, &currentRequest, NULL, waitTime) == osOK)
+        /* SFX finished: bring the music back where it left off */
+        if (activeSFX != TRACK_NONE && !AudioMixer_IsVoiceActive(MIXER_VOICE_SFX))
+        {
+            BGM_Restore(RESTORE_RAMP_MS);
+            activeSFX = TRACK_NONE;
+        }
+
+        pending = Pending_Take();
+        if (pending == 0)
         {
-            /* Process New Request */
-            noteIndex = 0;
-            currentTrack = currentRequest;
-
-            switch(currentRequest)
-            {
-                case TRACK_MENU:
-                    currentMelody = melody_menu;
-                    activeBGM = TRACK_MENU;
-                    break;
-                case TRACK_GAME_THEME_A:
-                    currentMelody = melody_game;
-                    activeBGM = TRACK_GAME_THEME_A;
-                    break;
-                case TRACK_GAME_OVER:
-                    currentMelody = melody_gameover;
-                    // SFX: don't change activeBGM
-                    break;
-                case TRACK_LINE_CLEAR:
-                    currentMelody = melody_clear;
-                    // SFX: don't change activeBGM
-                    break;
-                case TRACK_NONE:
-                default:
-                    currentMelody = NULL;
-                    activeBGM = TRACK_NONE;
-                    currentTrack = TRACK_NONE;
-                    SetFrequency(0);
-                    break;
-            }
+            osThreadFlagsWait(SOUND_FLAG_COMMAND, osFlagsWaitAny,
+                              (activeSFX != TRACK_NONE) ? SFX_POLL_MS : osWaitForever);
+            continue;
         }
-        
-        /* Play Logic */
-        if (currentMelody != NULL)
+
+        /* BGM: at most one bit is set */
+        if (pending & TRACK_BIT(TRACK_NONE))
         {
-            MusicNote note = currentMelody[noteIndex];
-            
-            /* Check for terminator */
-            if (note.duration == 0 && note.frequency == 0)
-            {
-                /* Termination/Loop Logic */
-                if (currentTrack == TRACK_MENU || currentTrack == TRACK_GAME_THEME_A)
-                {
-                    noteIndex = 0; // Restart BGM Loop
-                }
-                else
-                {
-                    /* SFX Finished: Wait a bit before resuming BGM */
-                    SetFrequency(0);
-                    osDelay(1000); // Increased gap to 1 second for better separation
-
-                    if (activeBGM != TRACK_NONE)
-                    {
-                        currentTrack = activeBGM;
-                        noteIndex = 0;
-                        currentMelody = (activeBGM == TRACK_MENU) ? melody_menu : melody_game;
-                    }
-                    else
-                    {
-                        currentTrack = TRACK_NONE;
-                        currentMelody = NULL;
-                        SetFrequency(0);
-                    }
-                }
-            }
-            else
-            {
-                /* Play Note */
-                SetFrequency(note.frequency);
-                osDelay(note.duration);
-                noteIndex++;
-            }
+            AudioMixer_StopAll();
+            BGM_Restore(0);
+            activeSFX = TRACK_NONE;
         }
+        else if (pending & TRACK_BIT(TRACK_MENU))
+        {
+            AudioMixer_PlaySong(MIXER_VOICE_BGM, BGM_VOICES, &song_menu, 1);
+        }
+        else if (pending & TRACK_BIT(TRACK_GAME_THEME_A))
+        {
+            AudioMixer_PlaySong(MIXER_VOICE_BGM, BGM_VOICES, &song_game, 1);
+        }
+
+        /* SFX: the highest-priority request of this batch wins */
+        sfx = TRACK_NONE;
+        if (pending & TRACK_BIT(TRACK_GAME_OVER))
+        {
+            sfx = TRACK_GAME_OVER;
+            if (pending & TRACK_BIT(TRACK_LINE_CLEAR)) Counter_Inc(&stats.dropped);
+        }
+        else if (pending & TRACK_BIT(TRACK_LINE_CLEAR))
+        {
+            sfx = TRACK_LINE_CLEAR;
+        }
+
+        if (sfx == TRACK_NONE)
+        {
+            continue;
+        }
+
+        /* Never cut a higher-priority SFX that is still playing */
+        if (AudioMixer_IsVoiceActive(MIXER_VOICE_SFX) &&
+            Track_Priority(sfx) < Track_Priority(activeSFX))
+        {
+            Counter_Inc(&stats.dropped);
+            continue;
+        }
+
+        BGM_Duck(sfx);
+        AudioMixer_PlaySong(MIXER_VOICE_SFX, SFX_VOICES,
+                            (sfx == TRACK_GAME_OVER) ? &song_gameover : &song_clear, 0);
+        activeSFX = sfx;
     }
 }
@@ -0,0 +1,381 @@
+/*
+ * TouchCalib.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "TouchCalib.h"
+#include <stdlib.h>
+
+#define Q16               65536
+#define FRAC_BITS         4       // IIR state in 1/16 raw units
+#define MEDIAN_MAX        5U
+#define RECORD_MAGIC      0x54434C31U // "TCL1"
+#define RECORD_WORDS      8U
+#define RECORD_COUNT      (TOUCHCAL_FLASH_SIZE / (RECORD_WORDS * 4U))
+#define MIN_DETERMINANT   200000  // Raw area spanned by the three taps
+#define MAX_GAIN          Q16     // |coefficient| <= 1 px per raw step
+
+/* Stored as 8 words: magic, a..f, check */
+typedef struct {
+    uint32_t magic;
+    TouchCalib_Transform transform;
+    uint32_t check;
+} TouchCalib_Record;
+
+/* Board defaults: the BSP mapping this module replaces, Y = (3700 - ry) / 11
+   on Rev D, (ry - 360) / 11 before. Its X was split, (3870 - rx) / 15 up to
+   rx = 3000 and (3800 - rx) / 15 above; an affine map has one offset, so X =
+   (3854 - rx) / 15, the least-squares fit over the panel's raw range
+   (270..3800): 1.1 px off the old mapping for rx <= 3000, 3.6 px above */
+static const TouchCalib_Transform defaultRevD = { -4369, 0, 16838383, 0, -5958, 22043927 };
+static const TouchCalib_Transform defaultRevC = { -4369, 0, 16838383, 0, 5958, -2144815 };
+
+/* Targets in screen pixels, spread over the panel and not on one line */
+static const uint16_t targets[TOUCHCAL_POINTS][2] = { {30, 40}, {210, 160}, {120, 280} };
+
+/* Internal State */
+static TouchCalib_Transform transform;
+static TouchCalib_Filter filter = { TOUCHCAL_MEDIAN_TAPS, TOUCHCAL_IIR_SHIFT, TOUCHCAL_DEADBAND_PX };
+static uint16_t maxX, maxY;
+
+static uint16_t historyX[MEDIAN_MAX], historyY[MEDIAN_MAX];
+static uint8_t historyCount;   // Valid entries, up to filter.medianTaps
+static uint8_t historyNext;
+static int32_t iirX, iirY;     // Q4
+static uint16_t outX, outY;
+static uint8_t haveOutput;
+
+static TouchCalib_State calState = TOUCHCAL_IDLE;
+static uint8_t calStep;
+static uint32_t sumX, sumY;
+static uint16_t sampleCount;
+static int32_t rawPoints[TOUCHCAL_POINTS][2];
+
+/* Helper: Cheap integrity check, so a torn write is never loaded */
+static uint32_t Record_Check(const TouchCalib_Record* record)
+{
+    const uint32_t* words = (const uint32_t*)record;
+    uint32_t check = 0x5A5A5A5AU;
+    uint32_t i;
+
+    for (i = 0; i < RECORD_WORDS - 1U; i++)
+    {
+        check = ((check << 5) | (check >> 27)) ^ words[i];
+    }
+    return check;
+}
+
+/* Helper: Newest valid record in the sector, NULL if none */
+static const TouchCalib_Record* Find_Latest(uint32_t* freeSlot)
+{
+    const TouchCalib_Record* records = (const TouchCalib_Record*)TOUCHCAL_FLASH_ADDR;
+    const TouchCalib_Record* latest = NULL;
+    uint32_t i;
+
+    for (i = 0; i < RECORD_COUNT; i++)
+    {
+        if (records[i].magic == 0xFFFFFFFFU)
+        {
+            break; // Erased: nothing written from here on
+        }
+        if (records[i].magic == RECORD_MAGIC && records[i].check == Record_Check(&records[i]))
+        {
+            latest = &records[i];
+        }
+    }
+    *freeSlot = i;
+    return latest;
+}
+
+/* Helper: Append a record, erasing the sector first when it is full. The
+   sector is in bank 2 and the code runs from bank 1, so only an erase
+   (~1 s, once every RECORD_COUNT saves) holds up the GUI task noticeably */
+static uint8_t Save(const TouchCalib_Transform* t)
+{
+    TouchCalib_Record record;
+    const uint32_t* words = (const uint32_t*)&record;
+    uint32_t slot, address, i;
+    uint8_t ok = 1;
+
+    record.magic = RECORD_MAGIC;
+    record.transform = *t;
+    record.check = Record_Check(&record);
+
+    Find_Latest(&slot);
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+                           FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+
+    if (slot >= RECORD_COUNT)
+    {
+        FLASH_EraseInitTypeDef erase = {0};
+        uint32_t sectorError;
+
+        erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+        erase.Sector = TOUCHCAL_FLASH_SECTOR;
+        erase.NbSectors = 1;
+        erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+        if (HAL_FLASHEx_Erase(&erase, &sectorError) != HAL_OK)
+        {
+            ok = 0;
+        }
+        slot = 0;
+    }
+
+    address = TOUCHCAL_FLASH_ADDR + slot * sizeof(TouchCalib_Record);
+    for (i = 0; ok && i < RECORD_WORDS; i++)
+    {
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + i * 4U, words[i]) != HAL_OK)
+        {
+            ok = 0;
+        }
+    }
+
+    HAL_FLASH_Lock();
+    return ok;
+}
+
+/* Helper: Median of the last n raw values (n <= 5, insertion sort) */
+static uint16_t Median(const uint16_t* history, uint8_t n)
+{
+    uint16_t sorted[MEDIAN_MAX];
+    uint8_t i, j;
+
+    for (i = 0; i < n; i++)
+    {
+        uint16_t v = history[i];
+        for (j = i; j > 0 && sorted[j - 1] > v; j--)
+        {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = v;
+    }
+    return sorted[n / 2];
+}
+
+/* Helper: Affine map and clamp to the screen */
+static uint16_t Map(int32_t p, int32_t q, int32_t r, int32_t rx, int32_t ry, uint16_t max)
+{
+    int32_t v = (p * rx + q * ry + r) >> 16;
+
+    if (v < 0)
+    {
+        return 0;
+    }
+    if (v >= (int32_t)max)
+    {
+        return max - 1;
+    }
+    return (uint16_t)v;
+}
+
+/* Helper: Solve the transform through the three taps (Cramer's rule) */
+static uint8_t Solve(TouchCalib_Transform* t)
+{
+    const int64_t x0 = rawPoints[0][0], y0 = rawPoints[0][1];
+    const int64_t x1 = rawPoints[1][0], y1 = rawPoints[1][1];
+    const int64_t x2 = rawPoints[2][0], y2 = rawPoints[2][1];
+    const int64_t X0 = targets[0][0], Y0 = targets[0][1];
+    const int64_t X1 = targets[1][0], Y1 = targets[1][1];
+    const int64_t X2 = targets[2][0], Y2 = targets[2][1];
+    int64_t k = (x0 - x2) * (y1 - y2) - (x1 - x2) * (y0 - y2);
+    int64_t a, b, c, d, e, f;
+
+    if (k < MIN_DETERMINANT && k > -MIN_DETERMINANT)
+    {
+        return 0; // Taps too close together or on one line
+    }
+
+    a = ((X0 - X2) * (y1 - y2) - (X1 - X2) * (y0 - y2)) * Q16 / k;
+    b = ((x0 - x2) * (X1 - X2) - (X0 - X2) * (x1 - x2)) * Q16 / k;
+    c = (y0 * (x2 * X1 - x1 * X2) + y1 * (x0 * X2 - x2 * X0) + y2 * (x1 * X0 - x0 * X1)) * Q16 / k;
+    d = ((Y0 - Y2) * (y1 - y2) - (Y1 - Y2) * (y0 - y2)) * Q16 / k;
+    e = ((x0 - x2) * (Y1 - Y2) - (Y0 - Y2) * (x1 - x2)) * Q16 / k;
+    f = (y0 * (x2 * Y1 - x1 * Y2) + y1 * (x0 * Y2 - x2 * Y0) + y2 * (x1 * Y0 - x0 * Y1)) * Q16 / k;
+
+    /* Keep a*rx + b*ry + c inside int32 for every 12-bit sample */
+    if (a > MAX_GAIN || a < -MAX_GAIN || b > MAX_GAIN || b < -MAX_GAIN ||
+        d > MAX_GAIN || d < -MAX_GAIN || e > MAX_GAIN || e < -MAX_GAIN ||
+        c > (1 << 29) || c < -(1 << 29) || f > (1 << 29) || f < -(1 << 29))
+    {
+        return 0;
+    }
+
+    t->a = (int32_t)a; t->b = (int32_t)b; t->c = (int32_t)c;
+    t->d = (int32_t)d; t->e = (int32_t)e; t->f = (int32_t)f;
+    return 1;
+}
+
+/* API Implementation */
+
+void TouchCalib_Init(uint8_t isRevD, uint16_t width, uint16_t height)
+{
+    const TouchCalib_Record* stored;
+    uint32_t slot;
+
+    maxX = width;
+    maxY = height;
+
+    stored = Find_Latest(&slot);
+    if (stored != NULL)
+    {
+        transform = stored->transform;
+    }
+    else
+    {
+        transform = isRevD ? defaultRevD : defaultRevC;
+    }
+    TouchCalib_Reset();
+}
+
+void TouchCalib_SetFilter(const TouchCalib_Filter* newFilter)
+{
+    filter = *newFilter;
+    if (filter.medianTaps > MEDIAN_MAX)
+    {
+        filter.medianTaps = MEDIAN_MAX;
+    }
+    if (filter.medianTaps == 0)
+    {
+        filter.medianTaps = 1;
+    }
+    TouchCalib_Reset();
+}
+
+void TouchCalib_Reset(void)
+{
+    historyCount = 0;
+    historyNext = 0;
+    haveOutput = 0;
+}
+
+void TouchCalib_Process(uint16_t rawX, uint16_t rawY, uint16_t* x, uint16_t* y)
+{
+    uint16_t medX, medY, screenX, screenY;
+    int32_t fx, fy;
+
+    /* 1. Median: removes single-sample spikes (pen landing and lifting) */
+    historyX[historyNext] = rawX;
+    historyY[historyNext] = rawY;
+    historyNext = (historyNext + 1U) % filter.medianTaps;
+    if (historyCount < filter.medianTaps)
+    {
+        historyCount++;
+    }
+    medX = Median(historyX, historyCount);
+    medY = Median(historyY, historyCount);
+
+    /* 2. IIR low pass: smooths ADC noise; starts at the first sample */
+    if (!haveOutput)
+    {
+        iirX = (int32_t)medX << FRAC_BITS;
+        iirY = (int32_t)medY << FRAC_BITS;
+    }
+    else
+    {
+        iirX += (((int32_t)medX << FRAC_BITS) - iirX) >> filter.iirShift;
+        iirY += (((int32_t)medY << FRAC_BITS) - iirY) >> filter.iirShift;
+    }
+    fx = (iirX + (1 << (FRAC_BITS - 1))) >> FRAC_BITS;
+    fy = (iirY + (1 << (FRAC_BITS - 1))) >> FRAC_BITS;
+
+    /* 3. Calibrated affine transform */
+    screenX = Map(transform.a, transform.b, transform.c, fx, fy, maxX);
+    screenY = Map(transform.d, transform.e, transform.f, fx, fy, maxY);
+
+    /* 4. Deadband: a resting finger reports one position */
+    if (!haveOutput ||
+        (uint32_t)(abs(screenX - outX) + abs(screenY - outY)) > filter.deadbandPx)
+    {
+        outX = screenX;
+        outY = screenY;
+        haveOutput = 1;
+    }
+    *x = outX;
+    *y = outY;
+}
+
+void TouchCalib_GetTransform(TouchCalib_Transform* out)
+{
+    *out = transform;
+}
+
+void TouchCalib_Start(void)
+{
+    calState = TOUCHCAL_RUNNING;
+    calStep = 0;
+    sumX = sumY = 0;
+    sampleCount = 0;
+}
+
+TouchCalib_State TouchCalib_GetState(void)
+{
+    return calState;
+}
+
+uint8_t TouchCalib_GetStep(void)
+{
+    return calStep;
+}
+
+void TouchCalib_GetTarget(uint8_t step, uint16_t* x, uint16_t* y)
+{
+    if (step >= TOUCHCAL_POINTS)
+    {
+        step = TOUCHCAL_POINTS - 1U;
+    }
+    *x = targets[step][0];
+    *y = targets[step][1];
+}
+
+void TouchCalib_CaptureSample(uint16_t rawX, uint16_t rawY)
+{
+    if (calState != TOUCHCAL_RUNNING)
+    {
+        return;
+    }
+    if (sampleCount++ < TOUCHCAL_SETTLE_SAMPLES)
+    {
+        return;
+    }
+    sumX += rawX;
+    sumY += rawY;
+}
+
+void TouchCalib_CaptureRelease(void)
+{
+    uint16_t used = (sampleCount > TOUCHCAL_SETTLE_SAMPLES) ? (sampleCount - TOUCHCAL_SETTLE_SAMPLES) : 0;
+    TouchCalib_Transform solved;
+
+    if (calState != TOUCHCAL_RUNNING)
+    {
+        return;
+    }
+
+    if (used >= TOUCHCAL_MIN_SAMPLES)
+    {
+        rawPoints[calStep][0] = (int32_t)(sumX / used);
+        rawPoints[calStep][1] = (int32_t)(sumY / used);
+        calStep++;
+    }
+    sumX = sumY = 0;
+    sampleCount = 0;
+
+    if (calStep < TOUCHCAL_POINTS)
+    {
+        return; // Next target (or the same one again after a short tap)
+    }
+
+    if (Solve(&solved))
+    {
+        transform = solved;
+        calState = Save(&transform) ? TOUCHCAL_SAVED : TOUCHCAL_UNSAVED;
+    }
+    else
+    {
+        calState = TOUCHCAL_FAILED;
+    }
+    TouchCalib_Reset();
+}
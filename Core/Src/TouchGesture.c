@@ -0,0 +1,216 @@
+/*
+ * TouchGesture.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "TouchGesture.h"
+#include "cmsis_os.h"
+
+/* Keys go where the buttons put theirs (StartDefaultTask), Model::tick reads them */
+extern osMessageQueueId_t inputQueueHandle;
+
+/* Positions are kept in 1/16 px so the filter does not lose motion to rounding */
+#define FRAC_BITS     4
+#define TO_FIX(px)    ((int32_t)(px) << FRAC_BITS)
+
+typedef enum {
+    GESTURE_IDLE,
+    GESTURE_TRACKING,
+    GESTURE_IGNORED   // Pen went down outside the area; wait for pen up
+} Gesture_State;
+
+typedef enum {
+    AXIS_NONE,        // Still within GESTURE_SLOP_PX: may become a tap
+    AXIS_HORIZONTAL,  // Moves
+    AXIS_DOWN,        // Soft drops, hard drop on a fast release
+    AXIS_UP           // No action
+} Gesture_Axis;
+
+/* Internal State */
+static uint8_t enabled = 0;
+static int16_t areaX, areaY, areaW, areaH;
+
+static Gesture_State state = GESTURE_IDLE;
+static Gesture_Axis axis;
+static uint32_t startMs;
+static uint32_t lastMs;     // Time of the last velocity update
+static int32_t fx, fy;      // Filtered position
+static int32_t prevFy;      // fy at lastMs
+static int32_t anchorX;     // Where the next move/drop is measured from
+static int32_t anchorY;
+static int32_t velocityY;   // px/s, downward positive
+static TouchGesture_Stats stats;
+static uint8_t tickBudget = GESTURE_MAX_MOVES; // Keys still allowed this GUI tick
+
+/* Helper: Queue one key like a button press; never blocks the GUI task.
+   Past the per-tick budget nothing is queued or lost: the caller keeps the
+   distance and retries on a later sample */
+static uint8_t Emit(uint8_t key)
+{
+    if (tickBudget == 0)
+    {
+        return 0;
+    }
+    if (osMessageQueuePut(inputQueueHandle, &key, 0, 0) != osOK)
+    {
+        stats.lost++;
+        return 0;
+    }
+    tickBudget--;
+    return 1;
+}
+
+static int32_t Abs(int32_t value)
+{
+    return (value < 0) ? -value : value;
+}
+
+/* Helper: One move per GESTURE_CELL_PX dragged, so the piece follows the finger */
+static void Track_Horizontal(void)
+{
+    while (Abs(fx - anchorX) >= TO_FIX(GESTURE_CELL_PX))
+    {
+        int8_t dir = (fx > anchorX) ? 1 : -1;
+
+        if (!Emit((dir > 0) ? 'R' : 'L'))
+        {
+            break; // Retried on the next sample
+        }
+        anchorX += dir * TO_FIX(GESTURE_CELL_PX);
+        stats.moves++;
+    }
+}
+
+/* Helper: One soft drop per GESTURE_CELL_PX dragged down */
+static void Track_Down(void)
+{
+    while ((fy - anchorY) >= TO_FIX(GESTURE_CELL_PX))
+    {
+        if (!Emit('D'))
+        {
+            break;
+        }
+        anchorY += TO_FIX(GESTURE_CELL_PX);
+        stats.softDrops++;
+    }
+}
+
+/* API Implementation */
+
+void TouchGesture_Enable(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    areaX = x;
+    areaY = y;
+    areaW = width;
+    areaH = height;
+    state = GESTURE_IDLE;
+    enabled = 1;
+}
+
+void TouchGesture_Disable(void)
+{
+    enabled = 0;
+    state = GESTURE_IDLE;
+}
+
+void TouchGesture_BeginTick(void)
+{
+    tickBudget = GESTURE_MAX_MOVES;
+}
+
+void TouchGesture_Sample(int16_t x, int16_t y, uint32_t timeMs)
+{
+    if (!enabled || state == GESTURE_IGNORED)
+    {
+        return;
+    }
+
+    if (state == GESTURE_IDLE)
+    {
+        if (x < areaX || x >= areaX + areaW || y < areaY || y >= areaY + areaH)
+        {
+            state = GESTURE_IGNORED; // Buttons and other widgets keep their clicks
+            return;
+        }
+        state = GESTURE_TRACKING;
+        axis = AXIS_NONE;
+        fx = anchorX = TO_FIX(x);
+        fy = anchorY = prevFy = TO_FIX(y);
+        velocityY = 0;
+        startMs = lastMs = timeMs;
+        return;
+    }
+
+    /* First-order low pass (alpha 1/2): takes the edge off ADC noise, lags ~1 sample */
+    fx += (TO_FIX(x) - fx) >> 1;
+    fy += (TO_FIX(y) - fy) >> 1;
+
+    /* Samples from one FIFO burst share a timestamp; velocity is updated
+       once per burst from the distance covered since the previous one */
+    if (timeMs != lastMs)
+    {
+        int32_t dt = (int32_t)(timeMs - lastMs);
+        int32_t v = ((fy - prevFy) * 1000 / dt) >> FRAC_BITS;
+
+        velocityY += (v - velocityY) >> 1;
+        prevFy = fy;
+        lastMs = timeMs;
+    }
+
+    /* The first axis to leave the slop wins for the rest of the gesture */
+    if (axis == AXIS_NONE)
+    {
+        int32_t dx = fx - anchorX;
+        int32_t dy = fy - anchorY;
+
+        if (Abs(dx) < TO_FIX(GESTURE_SLOP_PX) && Abs(dy) < TO_FIX(GESTURE_SLOP_PX))
+        {
+            return;
+        }
+        if (Abs(dx) >= Abs(dy))
+        {
+            axis = AXIS_HORIZONTAL;
+        }
+        else
+        {
+            axis = (dy > 0) ? AXIS_DOWN : AXIS_UP;
+        }
+    }
+
+    if (axis == AXIS_HORIZONTAL)
+    {
+        Track_Horizontal();
+    }
+    else if (axis == AXIS_DOWN)
+    {
+        Track_Down();
+    }
+}
+
+void TouchGesture_Release(uint32_t timeMs)
+{
+    if (state == GESTURE_TRACKING)
+    {
+        if (axis == AXIS_NONE && (timeMs - startMs) <= GESTURE_TAP_MAX_MS)
+        {
+            if (Emit('U'))
+            {
+                stats.taps++;
+            }
+        }
+        else if (axis == AXIS_DOWN && velocityY >= (int32_t)GESTURE_HARD_DROP_PX_S)
+        {
+            if (Emit('H'))
+            {
+                stats.hardDrops++;
+            }
+        }
+    }
+    state = GESTURE_IDLE;
+}
+
+void TouchGesture_GetStats(TouchGesture_Stats* out)
+{
+    *out = stats;
+}
@@ -0,0 +1,320 @@
+/*
+ * TouchSampler.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "TouchSampler.h"
+#include "stm32f4xx_hal.h"
+
+/* External I2C Handle and IO expander glue (main.c) */
+extern I2C_HandleTypeDef hi2c3;
+extern void IOE_Write(uint8_t Addr, uint8_t Reg, uint8_t Value);
+extern void IOE_ITConfig(void);
+
+/* STMPE811 Registers */
+#define REG_INT_CTRL       0x09U
+#define REG_INT_EN         0x0AU
+#define REG_INT_STA        0x0BU
+#define REG_TSC_CTRL       0x40U
+#define REG_FIFO_TH        0x4AU
+#define REG_FIFO_STA       0x4BU
+#define REG_FIFO_SIZE      0x4CU
+#define REG_TSC_DATA_XYZ   0xD7U // Non-incrementing: every 4 bytes pop one sample
+
+#define INT_TOUCH_DET      0x01U // Touch and lift-off
+#define INT_FIFO_TH        0x02U
+#define INT_FIFO_OFLOW     0x04U
+#define INT_CTRL_GLOBAL    0x01U // Level interrupt, active low
+#define TSC_CTRL_STA       0x80U // Pen down
+#define FIFO_STA_OFLOW     0x80U
+
+#define STATUS_LEN         (REG_FIFO_SIZE - REG_TSC_CTRL + 1U) // TSC_CTRL..FIFO_SIZE in one read
+#define SAMPLE_BYTES       4U
+#define RING_MASK          (TOUCH_RING_SIZE - 1U)
+
+#define INT_PORT           GPIOA
+#define INT_PIN            GPIO_PIN_15
+
+/* One interrupt is served as STATUS -> FIFO (if samples) -> CLEAR, all
+   interrupt driven; CLEAR loops back to STATUS while INT stays low */
+typedef enum {
+    STATE_IDLE,
+    STATE_STATUS,
+    STATE_FIFO,
+    STATE_CLEAR
+} Sampler_State;
+
+/* Internal State */
+static DMA_HandleTypeDef hdma_touch; // I2C3_RX (DMA1 Stream2 Ch3)
+/* DMA targets: main SRAM, never CCM */
+static uint8_t status[STATUS_LEN];
+static uint8_t burst[TOUCH_BURST_SAMPLES * SAMPLE_BYTES];
+static uint8_t clearAll = 0xFF;
+
+static volatile Sampler_State state = STATE_IDLE;
+static volatile uint32_t stateSinceMs;
+static uint16_t burstSamples;
+static uint8_t moreInFifo;     // FIFO held more than one burst
+static uint8_t pendingTouched; // Pen state from STATUS, published after the samples
+
+/* Single producer (I2C callbacks) writes head, single consumer (GUI task) writes tail */
+static TouchSampler_Sample ring[TOUCH_RING_SIZE];
+static volatile uint32_t ringHead = 0;
+static volatile uint32_t ringTail = 0;
+static volatile uint8_t touched = 0;
+static volatile TouchSampler_Stats stats;
+
+/* Helper: Give up on the current transfer; the next INT edge or Poll retries */
+static void Fail(void)
+{
+    stats.errors++;
+    state = STATE_IDLE;
+}
+
+/* Helper: Take the bus if nothing is in flight (any context) */
+static uint8_t Claim(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint8_t claimed = 0;
+
+    __disable_irq();
+    if (state == STATE_IDLE)
+    {
+        state = STATE_STATUS;
+        stateSinceMs = HAL_GetTick();
+        claimed = 1;
+    }
+    __set_PRIMASK(primask);
+    return claimed;
+}
+
+/* Helper: Step 1, pen state and FIFO level in one burst */
+static void Read_Status(void)
+{
+    state = STATE_STATUS;
+    if (HAL_I2C_Mem_Read_DMA(&hi2c3, TOUCH_I2C_ADDRESS, REG_TSC_CTRL, I2C_MEMADD_SIZE_8BIT,
+                             status, STATUS_LEN) != HAL_OK)
+    {
+        Fail();
+    }
+}
+
+/* Helper: Step 2, pop up to TOUCH_BURST_SAMPLES samples */
+static void Read_Fifo(void)
+{
+    state = STATE_FIFO;
+    if (HAL_I2C_Mem_Read_DMA(&hi2c3, TOUCH_I2C_ADDRESS, REG_TSC_DATA_XYZ, I2C_MEMADD_SIZE_8BIT,
+                             burst, burstSamples * SAMPLE_BYTES) != HAL_OK)
+    {
+        Fail();
+    }
+}
+
+/* Helper: Step 3, acknowledge every source so INT is released */
+static void Clear_Interrupts(void)
+{
+    state = STATE_CLEAR;
+    if (HAL_I2C_Mem_Write_IT(&hi2c3, TOUCH_I2C_ADDRESS, REG_INT_STA, I2C_MEMADD_SIZE_8BIT,
+                             &clearAll, 1) != HAL_OK)
+    {
+        Fail();
+    }
+}
+
+/* Helper: Unpack a burst into the ring (producer side) */
+static void Push_Burst(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint16_t i;
+
+    for (i = 0; i < burstSamples; i++)
+    {
+        const uint8_t* data = &burst[i * SAMPLE_BYTES];
+        TouchSampler_Sample* sample;
+
+        if ((ringHead - ringTail) >= TOUCH_RING_SIZE)
+        {
+            stats.dropped++;
+            continue;
+        }
+
+        /* X[11:0] Y[11:0] Z[7:0], as stmpe811_TS_GetXY unpacks it */
+        sample = &ring[ringHead & RING_MASK];
+        sample->x = (uint16_t)((data[0] << 4) | (data[1] >> 4));
+        sample->y = (uint16_t)(((data[1] & 0x0FU) << 8) | data[2]);
+        sample->z = data[3];
+        sample->timeMs = now;
+        ringHead++;
+    }
+    stats.samples += burstSamples;
+}
+
+/* API Implementation */
+
+void TouchSampler_Init(void)
+{
+    /* I2C3_RX stream; the address phase and the INT_STA write use I2C3 interrupts */
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    hdma_touch.Instance = DMA1_Stream2;
+    hdma_touch.Init.Channel = DMA_CHANNEL_3;
+    hdma_touch.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_touch.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_touch.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_touch.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_touch.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_touch.Init.Mode = DMA_NORMAL;
+    hdma_touch.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_touch.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_touch) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    __HAL_LINKDMA(&hi2c3, hdmarx, hdma_touch);
+
+    /* Same level as other RTOS-aware interrupts */
+    HAL_NVIC_SetPriority(DMA1_Stream2_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream2_IRQn);
+    HAL_NVIC_SetPriority(I2C3_EV_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(I2C3_EV_IRQn);
+    HAL_NVIC_SetPriority(I2C3_ER_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(I2C3_ER_IRQn);
+
+    /* STMPE811 (still polled here): interrupt every TOUCH_FIFO_THRESHOLD
+       samples, on touch and lift-off, and on FIFO overflow */
+    IOE_Write(TOUCH_I2C_ADDRESS, REG_FIFO_TH, TOUCH_FIFO_THRESHOLD);
+    IOE_Write(TOUCH_I2C_ADDRESS, REG_INT_EN, INT_TOUCH_DET | INT_FIFO_TH | INT_FIFO_OFLOW);
+    IOE_Write(TOUCH_I2C_ADDRESS, REG_INT_STA, 0xFF);
+    IOE_Write(TOUCH_I2C_ADDRESS, REG_INT_CTRL, INT_CTRL_GLOBAL);
+
+    IOE_ITConfig(); // PA15 falling edge on EXTI15_10
+}
+
+uint8_t TouchSampler_Read(TouchSampler_Sample* sample)
+{
+    if (ringHead == ringTail)
+    {
+        return 0;
+    }
+    *sample = ring[ringTail & RING_MASK];
+    ringTail++;
+    return 1;
+}
+
+uint8_t TouchSampler_IsTouched(void)
+{
+    return touched;
+}
+
+void TouchSampler_Poll(void)
+{
+    if (state == STATE_IDLE)
+    {
+        /* INT held low without an edge (it fell while the bus was busy) */
+        if (HAL_GPIO_ReadPin(INT_PORT, INT_PIN) == GPIO_PIN_RESET && Claim())
+        {
+            Read_Status();
+        }
+    }
+    else if ((HAL_GetTick() - stateSinceMs) > TOUCH_STUCK_MS)
+    {
+        /* Lost transfer: start over with a freshly initialized peripheral */
+        HAL_NVIC_DisableIRQ(I2C3_EV_IRQn);
+        HAL_NVIC_DisableIRQ(I2C3_ER_IRQn);
+        HAL_NVIC_DisableIRQ(DMA1_Stream2_IRQn);
+
+        HAL_DMA_Abort(&hdma_touch);
+        HAL_I2C_DeInit(&hi2c3);
+        HAL_I2C_Init(&hi2c3);
+        Fail();
+
+        HAL_NVIC_EnableIRQ(DMA1_Stream2_IRQn);
+        HAL_NVIC_EnableIRQ(I2C3_ER_IRQn);
+        HAL_NVIC_EnableIRQ(I2C3_EV_IRQn);
+    }
+}
+
+void TouchSampler_GetStats(TouchSampler_Stats* out)
+{
+    *out = stats;
+}
+
+void TouchSampler_EXTI_Callback(void)
+{
+    stats.interrupts++;
+    if (Claim())
+    {
+        Read_Status();
+    }
+}
+
+void TouchSampler_DMA_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_touch);
+}
+
+/* HAL I2C Callbacks (I2C3 is only used by the touch controller) */
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    if (hi2c != &hi2c3)
+    {
+        return;
+    }
+
+    if (state == STATE_STATUS)
+    {
+        uint8_t fifoSize = status[REG_FIFO_SIZE - REG_TSC_CTRL];
+
+        if (status[REG_FIFO_STA - REG_TSC_CTRL] & FIFO_STA_OFLOW)
+        {
+            stats.dropped++;
+        }
+        pendingTouched = (status[0] & TSC_CTRL_STA) ? 1 : 0;
+        moreInFifo = (fifoSize > TOUCH_BURST_SAMPLES);
+        burstSamples = moreInFifo ? TOUCH_BURST_SAMPLES : fifoSize;
+
+        if (burstSamples > 0)
+        {
+            Read_Fifo();
+            return;
+        }
+        touched = pendingTouched;
+        Clear_Interrupts();
+    }
+    else if (state == STATE_FIFO)
+    {
+        stats.bursts++;
+        Push_Burst();
+        touched = pendingTouched; // Lift-off only after its last samples are readable
+        Clear_Interrupts();
+    }
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    if (hi2c != &hi2c3 || state != STATE_CLEAR)
+    {
+        return;
+    }
+
+    /* INT is level triggered: still low means samples arrived meanwhile */
+    if (moreInFifo || HAL_GPIO_ReadPin(INT_PORT, INT_PIN) == GPIO_PIN_RESET)
+    {
+        stateSinceMs = HAL_GetTick();
+        Read_Status();
+    }
+    else
+    {
+        state = STATE_IDLE;
+    }
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c)
+{
+    if (hi2c == &hi2c3)
+    {
+        Fail();
+    }
+}
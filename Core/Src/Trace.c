@@ -0,0 +1,100 @@
+/*
+ * Trace.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "Trace.h"
+#include "main.h"
+#include "CcmRam.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include <stddef.h>
+#include <string.h>
+
+/* Ring in external SDRAM (section placed by STM32F429XX_FLASH.ld, not zeroed
+   by the startup code; Trace_Init clears the header) */
+TraceBuffer traceBuffer __attribute__((section("TraceBuffer")));
+
+/* Internal State (CCM, read on every event) */
+static volatile uint8_t running CCM_BSS;
+static uint32_t head CCM_BSS;
+static uint16_t currentTask CCM_BSS;
+static uint32_t queueCount = 0;
+
+/* API Implementation */
+
+void Trace_Init(void)
+{
+    // Cycle counter for timestamps (also used by the mixer statistics)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    memset(&traceBuffer, 0, offsetof(TraceBuffer, records));
+    traceBuffer.magic = TRACE_MAGIC;
+    traceBuffer.version = TRACE_VERSION;
+    traceBuffer.cpuHz = SystemCoreClock;
+    traceBuffer.recordCount = TRACE_RECORD_COUNT;
+    head = 0;
+
+    running = TRACE_ENABLED;
+}
+
+/* ~30 cycles: a few register reads and one 12-byte store to SDRAM */
+void Trace_Event(uint16_t event, uint32_t arg)
+{
+    uint32_t ipsr = __get_IPSR();
+    uint32_t primask;
+    TraceRecord* record;
+
+    if (!running)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    record = &traceBuffer.records[head & (TRACE_RECORD_COUNT - 1)];
+    record->cycles = DWT->CYCCNT;
+    record->event = event;
+    record->context = ipsr ? (uint16_t)(TRACE_CONTEXT_ISR | ipsr) : currentTask;
+    record->arg = arg;
+    traceBuffer.head = ++head;
+
+    __set_PRIMASK(primask);
+}
+
+/* traceTASK_SWITCHED_IN hook, runs inside the scheduler */
+void Trace_TaskSwitchedIn(uint32_t taskNumber)
+{
+    if (taskNumber == currentTask)
+    {
+        return; // Same task selected again, not a switch
+    }
+    currentTask = (uint16_t)taskNumber;
+    Trace_Event(TRACE_EVT_TASK_SWITCH, taskNumber);
+}
+
+/* traceTASK_CREATE hook */
+void Trace_TaskCreated(uint32_t taskNumber, const char* name)
+{
+    if (!running || taskNumber >= TRACE_MAX_TASKS)
+    {
+        return;
+    }
+    strncpy(traceBuffer.taskNames[taskNumber], name, TRACE_NAME_LEN - 1);
+}
+
+/* Gives a queue (or semaphore) a number for TRACE_EVT_QUEUE_* records.
+   Unnamed queues are reported as queue 0. */
+void Trace_NameQueue(void* queue, const char* name)
+{
+    if (!running || queue == NULL || queueCount + 1 >= TRACE_MAX_QUEUES)
+    {
+        return;
+    }
+    queueCount++;
+    vQueueSetQueueNumber((QueueHandle_t)queue, queueCount);
+    strncpy(traceBuffer.queueNames[queueCount], name, TRACE_NAME_LEN - 1);
+}
@@ -25,7 +25,8 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-
+#include "MemoryMonitor.h"
+#include "CcmRam.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -45,6 +46,12 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
+/* Idle and timer task memory in CCM: the idle task runs on every pass
+   through tickless idle, away from the LTDC/DMA2D traffic in main SRAM. */
+static StaticTask_t idleTaskTCB CCM_BSS;
+static StackType_t idleTaskStack[configMINIMAL_STACK_SIZE] CCM_BSS;
+static StaticTask_t timerTaskTCB CCM_BSS;
+static StackType_t timerTaskStack[configTIMER_TASK_STACK_DEPTH] CCM_BSS;
 
 /* USER CODE END Variables */
 
@@ -55,6 +62,33 @@
 
 /* Private application code --------------------------------------------------*/
 /* USER CODE BEGIN Application */
-     
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
+{
+  /* Overrides the weak version in cmsis_os2.c, which uses main SRAM */
+  *ppxIdleTaskTCBBuffer = &idleTaskTCB;
+  *ppxIdleTaskStackBuffer = &idleTaskStack[0];
+  *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize)
+{
+  *ppxTimerTaskTCBBuffer = &timerTaskTCB;
+  *ppxTimerTaskStackBuffer = &timerTaskStack[0];
+  *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+void vApplicationStackOverflowHook(TaskHandle_t xTask, signed char *pcTaskName)
+{
+  /* Called by the scheduler (configCHECK_FOR_STACK_OVERFLOW = 2) when a task
+     has used its whole stack or overwritten the guard pattern at its end. */
+  (void)xTask;
+  MemoryMonitor_StackOverflow((const char*)pcTaskName);
+}
+
+void vApplicationMallocFailedHook(void)
+{
+  /* Called by heap_4 when pvPortMalloc cannot satisfy a request. */
+  MemoryMonitor_MallocFailed();
+}
 /* USER CODE END Application */
 
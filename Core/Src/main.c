@@ -27,6 +27,18 @@
 #include "Components/ili9341/ili9341.h"
 #include <stdio.h>
 #include "SoundEngine.h"
+#include "EntropyPool.h"
+#include "PowerManager.h"
+#include "Profiler.h"
+#include "Trace.h"
+#include "CcmRam.h"
+#include "RamFunc.h"
+#include "TouchSampler.h"
+#include "TouchGesture.h"
+#include "LcdCommand.h"
+#include "BootProfile.h"
+#include "SdramTest.h"
+#include "SdramBench.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -59,6 +71,10 @@ typedef struct {
 
 #define I2C3_TIMEOUT_MAX                    0x3000 /*<! The value of the maximal timeout for I2C waiting loops */
 #define SPI5_TIMEOUT_MAX                    0x1000
+
+#define INPUT_QUEUE_LENGTH                  (4 + GESTURE_MAX_MOVES) /* One key per button plus the capped touch keys of one GUI tick */
+#define SOUND_TASK_STACK_WORDS              256
+#define PROFILER_TASK_STACK_WORDS           384
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -117,6 +133,17 @@ volatile uint32_t last_irq_time_up = 0;
 volatile uint32_t last_irq_time_down = 0;
 volatile uint32_t last_irq_time_left = 0;
 volatile uint32_t last_irq_time_right = 0;
+
+/* Input queues and small task stacks live in CCM: the EXTI handlers and the
+   game loop touch them every frame, and CCM never waits behind LTDC/DMA2D. */
+static StaticQueue_t inputQueueControlBlock CCM_BSS;
+static uint8_t inputQueueBuffer[INPUT_QUEUE_LENGTH * sizeof(uint8_t)] CCM_BSS;
+static StaticQueue_t buttonEventQueueControlBlock CCM_BSS;
+static uint8_t buttonEventQueueBuffer[INPUT_QUEUE_LENGTH * sizeof(ButtonEvent_t)] CCM_BSS;
+static StaticTask_t soundTaskControlBlock CCM_BSS;
+static uint32_t soundTaskBuffer[SOUND_TASK_STACK_WORDS] CCM_BSS;
+static StaticTask_t profilerTaskControlBlock CCM_BSS;
+static uint32_t profilerTaskBuffer[PROFILER_TASK_STACK_WORDS] CCM_BSS;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -135,12 +162,6 @@ void StartDefaultTask(void *argument);
 extern void TouchGFX_Task(void *argument);
 
 /* USER CODE BEGIN PFP */
-void Buzzer_SetFrequency(uint32_t freq);
-void Buzzer_Stop(void);
-
-void Play_Startup_Melody(void);
-void MarioMusicTask(void *argument);
-
 void CallbackTimerUp(void *argument);
 void CallbackTimerDown(void *argument);
 static void BSP_SDRAM_Initialization_Sequence(SDRAM_HandleTypeDef *hsdram, FMC_SDRAM_CommandTypeDef *Command);
@@ -176,85 +197,6 @@ uint16_t                  IOE_ReadMultiple(uint8_t Addr, uint8_t Reg, uint8_t *p
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
 
-/* ===== BUZZER CORE ===== */
-void Buzzer_SetFrequency(uint32_t freq)
-{
-    if (freq == 0)
-    {
-        __HAL_TIM_SET_COMPARE(&htim10, TIM_CHANNEL_1, 0);
-        return;
-    }
-
-    /* Timer runs at 1MHz (Prescaler 167 for 168MHz APB2) */
-    uint32_t period = (1000000 / freq) - 1;
-    __HAL_TIM_SET_AUTORELOAD(&htim10, period);
-    __HAL_TIM_SET_COMPARE(&htim10, TIM_CHANNEL_1, period / 2);
-}
-
-void Buzzer_Stop(void)
-{
-    __HAL_TIM_SET_COMPARE(&htim10, TIM_CHANNEL_1, 0);
-}
-
-/* ===== NOTE DEFINITIONS ===== */
-#define C4 262
-#define D4 294
-#define E4 330
-#define F4 349
-#define G4 392
-#define A4 440
-#define B4 494
-#define C5 523
-#define E5 659
-#define G5 784
-
-/* ===== STARTUP MELODY ===== */
-void Play_Startup_Melody(void)
-{
-    Buzzer_SetFrequency(C4); HAL_Delay(150);
-    Buzzer_SetFrequency(E4); HAL_Delay(150);
-    Buzzer_SetFrequency(G4); HAL_Delay(150);
-    Buzzer_SetFrequency(C5); HAL_Delay(300);
-    Buzzer_Stop();
-}
-
-/* ===== MARIO THEME (LOOP) ===== */
-const uint16_t mario_notes[] = {
-    E5, E5, 0, E5, 0, C5, E5, 0,
-    G5, 0, 0, 0,
-    G4, 0, 0, 0
-};
-
-const uint16_t mario_durations[] = {
-    100,100,100,100,100,100,100,100,
-    300,100,100,100,
-    300,100,100,100
-};
-
-void MarioMusicTask(void *argument)
-{
-    /* Ensure PWM is started */
-    HAL_TIM_PWM_Start(&htim10, TIM_CHANNEL_1);
-
-    uint32_t i = 0;
-    const uint32_t len = sizeof(mario_notes)/sizeof(mario_notes[0]);
-
-    for (;;)
-    {
-        if (mario_notes[i] == 0) {
-             Buzzer_Stop();
-        } else {
-             Buzzer_SetFrequency(mario_notes[i]);
-        }
-        osDelay(mario_durations[i]);
-
-        i++;
-        if (i >= len) i = 0;
-    }
-}
-
-static LCD_DrvTypeDef* LcdDrv;
-
 uint32_t I2c3Timeout = I2C3_TIMEOUT_MAX; /*<! Value of Timeout when I2C communication fails */
 uint32_t Spi5Timeout = SPI5_TIMEOUT_MAX; /*<! Value of Timeout when SPI communication fails */
 /* USER CODE END 0 */
@@ -267,7 +209,7 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
-
+  BootProfile_Start(); // Boot timeline: every stage below is stamped with DWT cycles
   /* USER CODE END 1 */
 
   /* MCU Configuration--------------------------------------------------------*/
@@ -276,14 +218,14 @@ int main(void)
   HAL_Init();
 
   /* USER CODE BEGIN Init */
-
+  BootProfile_Mark(BOOT_STAGE_HAL);
   /* USER CODE END Init */
 
   /* Configure the system clock */
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
-
+  BootProfile_Mark(BOOT_STAGE_CLOCK);
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
@@ -301,8 +243,17 @@ int main(void)
   /* Call PreOsInit function */
   MX_TouchGFX_PreOSInit();
   /* USER CODE BEGIN 2 */
+  BootProfile_Mark(BOOT_STAGE_PERIPHERALS);
+
+  SdramTest_ClearFramebuffers();
+#if SDRAMBENCH_AT_BOOT
+  SdramBench_Run(); // CPU and DMA2D rates, with and without LTDC; in the {"sdram_bench":...} line
+#endif
+  BootProfile_Mark(BOOT_STAGE_MEMORY);
 
+  Trace_Init(); // SDRAM is up, tasks and queues created from here on are named
   SoundEngine_Init();
+  PowerManager_Init();
   
   /* USER CODE END 2 */
 
@@ -328,8 +279,23 @@ int main(void)
 
   /* USER CODE BEGIN RTOS_QUEUES */
   /* add queues, ... */
-  inputQueueHandle = osMessageQueueNew(2, sizeof(uint8_t), NULL);
-  buttonEventQueueHandle = osMessageQueueNew(2, sizeof(ButtonEvent_t), NULL);
+  const osMessageQueueAttr_t inputQueue_attributes = {
+    .cb_mem = &inputQueueControlBlock,
+    .cb_size = sizeof(inputQueueControlBlock),
+    .mq_mem = inputQueueBuffer,
+    .mq_size = sizeof(inputQueueBuffer),
+  };
+  inputQueueHandle = osMessageQueueNew(INPUT_QUEUE_LENGTH, sizeof(uint8_t), &inputQueue_attributes);
+
+  const osMessageQueueAttr_t buttonEventQueue_attributes = {
+    .cb_mem = &buttonEventQueueControlBlock,
+    .cb_size = sizeof(buttonEventQueueControlBlock),
+    .mq_mem = buttonEventQueueBuffer,
+    .mq_size = sizeof(buttonEventQueueBuffer),
+  };
+  buttonEventQueueHandle = osMessageQueueNew(INPUT_QUEUE_LENGTH, sizeof(ButtonEvent_t), &buttonEventQueue_attributes);
+  Trace_NameQueue(inputQueueHandle, "inputQueue");
+  Trace_NameQueue(buttonEventQueueHandle, "buttonQueue");
   /* USER CODE END RTOS_QUEUES */
 
   /* Create the thread(s) */
@@ -344,14 +310,28 @@ int main(void)
   
   const osThreadAttr_t soundTask_attributes = {
     .name = "SoundTask",
-    .stack_size = 256 * 4,
+    .cb_mem = &soundTaskControlBlock,
+    .cb_size = sizeof(soundTaskControlBlock),
+    .stack_mem = soundTaskBuffer,
+    .stack_size = sizeof(soundTaskBuffer),
     .priority = (osPriority_t) osPriorityLow,
   };
   osThreadNew(SoundEngineTask, NULL, &soundTask_attributes);
+
+  const osThreadAttr_t profilerTask_attributes = {
+    .name = "ProfilerTask",
+    .cb_mem = &profilerTaskControlBlock,
+    .cb_size = sizeof(profilerTaskControlBlock),
+    .stack_mem = profilerTaskBuffer,
+    .stack_size = sizeof(profilerTaskBuffer),
+    .priority = (osPriority_t) osPriorityLow,
+  };
+  osThreadNew(ProfilerTask, NULL, &profilerTask_attributes);
   /* USER CODE END RTOS_THREADS */
 
   /* USER CODE BEGIN RTOS_EVENTS */
   /* add events, ... */
+  BootProfile_Mark(BOOT_STAGE_RTOS);
   /* USER CODE END RTOS_EVENTS */
 
   /* Start scheduler */
@@ -494,7 +474,7 @@ static void MX_I2C3_Init(void)
 
   /* USER CODE END I2C3_Init 1 */
   hi2c3.Instance = I2C3;
-  hi2c3.Init.ClockSpeed = 100000;
+  hi2c3.Init.ClockSpeed = 400000;
   hi2c3.Init.DutyCycle = I2C_DUTYCYCLE_2;
   hi2c3.Init.OwnAddress1 = 0;
   hi2c3.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
@@ -583,12 +563,13 @@ static void MX_LTDC_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN LTDC_Init 2 */
-    /*Select the device */
-  LcdDrv = &ili9341_drv;
-  /* LCD Init */
-  LcdDrv->Init();
-
-  LcdDrv->DisplayOff();
+  /* ILI9341 init: queued and sent by SPI DMA while the boot continues
+     (the panel stays off until TouchGFXHAL::taskEntry has a frame) */
+  LcdCommand_Init();
+#if !BOOT_FAST
+  LcdCommand_Flush(); // Serial boot: wait for the panel here, as the blocking BSP driver did
+#endif
+  BootProfile_Mark(BOOT_STAGE_LCD);
   /* USER CODE END LTDC_Init 2 */
 
 }
@@ -614,6 +595,7 @@ static void MX_RNG_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN RNG_Init 2 */
+  EntropyPool_Init();
 
   /* USER CODE END RNG_Init 2 */
 
@@ -796,6 +778,10 @@ static void MX_FMC_Init(void)
 
   /* Program the SDRAM external device */
   BSP_SDRAM_Initialization_Sequence(&hsdram1, &command);
+#if SDRAMTEST_MARCH
+  SdramTest_March(); // Before anything lives in SDRAM; result in the {"sdram":...} line
+#endif
+  BootProfile_Mark(BOOT_STAGE_SDRAM);
   /* USER CODE END FMC_Init 2 */
 }
 
@@ -899,7 +885,7 @@ static void MX_GPIO_Init(void)
   * @param  GPIO_Pin: Specifies the port pin connected to corresponding EXTI line.
   * @retval None
   */
-void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+RAM_FUNC void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 {
   uint32_t current_time = HAL_GetTick();
   ButtonEvent_t event;
@@ -950,9 +936,14 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
         }
       }
       break;
+
+    case GPIO_PIN_15: // STMPE811 INT (PA15)
+      TouchSampler_EXTI_Callback();
+      break;
   }
 
   if (send_event) {
+    PowerManager_NotifyInput();
     osMessageQueuePut(buttonEventQueueHandle, &event, 0, 0);
   }
 }
@@ -991,8 +982,12 @@ static void BSP_SDRAM_Initialization_Sequence(SDRAM_HandleTypeDef *hsdram, FMC_S
   HAL_SDRAM_SendCommand(hsdram, Command, SDRAM_TIMEOUT);
 
   /* Step 2: Insert 100 us minimum delay */
+#if BOOT_FAST
+  BootProfile_DelayUs(100);
+#else
   /* Inserted delay is equal to 1 ms due to systick time base unit (ms) */
   HAL_Delay(1);
+#endif
 
   /* Step 3: Configure a PALL (precharge all) command */
   Command->CommandMode             = FMC_SDRAM_CMD_PALL;
@@ -1046,8 +1041,15 @@ void IOE_Init(void)
   */
 void IOE_ITConfig(void)
 {
-  //Dummy function called when initializing to stmpe811 to setup interupt for the i2c.
-  //The interupt is not used in our case, therefore nothing is done here.
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  /* STMPE811 INT is open drain, active low (pulled up on the board); it shares
+     EXTI15_10 with the RIGHT button and is served by TouchSampler */
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+  GPIO_InitStruct.Pin = GPIO_PIN_15;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 }
 
 /**
@@ -1378,7 +1380,10 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
-
+  if (htim->Instance == TIM6)
+  {
+    LcdCommand_Tick(); // Resumes a command list after an LCDCMD_DELAY
+  }
   /* USER CODE END Callback 1 */
 }
 
@@ -462,6 +462,9 @@ void HAL_RNG_MspInit(RNG_HandleTypeDef* hrng)
     /* Peripheral clock enable */
     __HAL_RCC_RNG_CLK_ENABLE();
     /* USER CODE BEGIN RNG_MspInit 1 */
+    /* RNG interrupt feeds the entropy pool (EntropyPool.c) */
+    HAL_NVIC_SetPriority(HASH_RNG_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(HASH_RNG_IRQn);
 
     /* USER CODE END RNG_MspInit 1 */
 
@@ -485,6 +488,7 @@ void HAL_RNG_MspDeInit(RNG_HandleTypeDef* hrng)
     /* Peripheral clock disable */
     __HAL_RCC_RNG_CLK_DISABLE();
     /* USER CODE BEGIN RNG_MspDeInit 1 */
+    HAL_NVIC_DisableIRQ(HASH_RNG_IRQn);
 
     /* USER CODE END RNG_MspDeInit 1 */
   }
@@ -660,6 +664,9 @@ void HAL_UART_MspInit(UART_HandleTypeDef* huart)
     HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
     /* USER CODE BEGIN USART1_MspInit 1 */
+    /* TX interrupt for the profiler dump */
+    HAL_NVIC_SetPriority(USART1_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(USART1_IRQn);
 
     /* USER CODE END USART1_MspInit 1 */
 
@@ -690,6 +697,7 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* huart)
     HAL_GPIO_DeInit(GPIOA, GPIO_PIN_9|GPIO_PIN_10);
 
     /* USER CODE BEGIN USART1_MspDeInit 1 */
+    HAL_NVIC_DisableIRQ(USART1_IRQn);
 
     /* USER CODE END USART1_MspDeInit 1 */
   }
@@ -23,6 +23,11 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "AudioMixer.h"
+#include "Trace.h"
+#include "RamFunc.h"
+#include "TouchSampler.h"
+#include "LcdCommand.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -47,6 +52,12 @@
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN PFP */
+/* Input and graphics interrupts run from SRAM (RamFunc.h); the attribute on
+   these declarations carries over to the generated definitions below */
+RAM_FUNC void EXTI2_IRQHandler(void);
+RAM_FUNC void EXTI3_IRQHandler(void);
+RAM_FUNC void EXTI15_10_IRQHandler(void);
+RAM_FUNC void DMA2D_IRQHandler(void);
 
 /* USER CODE END PFP */
 
@@ -61,6 +72,9 @@ extern LTDC_HandleTypeDef hltdc;
 extern TIM_HandleTypeDef htim6;
 
 /* USER CODE BEGIN EV */
+extern RNG_HandleTypeDef hrng;
+extern UART_HandleTypeDef huart1;
+extern I2C_HandleTypeDef hi2c3;
 
 /* USER CODE END EV */
 
@@ -166,11 +180,11 @@ void DebugMon_Handler(void)
 void EXTI2_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI2_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END EXTI2_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_2);
   /* USER CODE BEGIN EXTI2_IRQn 1 */
-
+  TRACE_ISR_EXIT();
   /* USER CODE END EXTI2_IRQn 1 */
 }
 
@@ -180,11 +194,11 @@ void EXTI2_IRQHandler(void)
 void EXTI3_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI3_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END EXTI3_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_3);
   /* USER CODE BEGIN EXTI3_IRQn 1 */
-
+  TRACE_ISR_EXIT();
   /* USER CODE END EXTI3_IRQn 1 */
 }
 
@@ -194,12 +208,13 @@ void EXTI3_IRQHandler(void)
 void EXTI15_10_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI15_10_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END EXTI15_10_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_12);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_13);
   /* USER CODE BEGIN EXTI15_10_IRQn 1 */
-
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_15); // STMPE811 INT (TouchSampler)
+  TRACE_ISR_EXIT();
   /* USER CODE END EXTI15_10_IRQn 1 */
 }
 
@@ -223,11 +238,11 @@ void TIM6_DAC_IRQHandler(void)
 void LTDC_IRQHandler(void)
 {
   /* USER CODE BEGIN LTDC_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END LTDC_IRQn 0 */
   HAL_LTDC_IRQHandler(&hltdc);
   /* USER CODE BEGIN LTDC_IRQn 1 */
-
+  TRACE_ISR_EXIT();
   /* USER CODE END LTDC_IRQn 1 */
 }
 
@@ -237,14 +252,84 @@ void LTDC_IRQHandler(void)
 void DMA2D_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2D_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END DMA2D_IRQn 0 */
   HAL_DMA2D_IRQHandler(&hdma2d);
   /* USER CODE BEGIN DMA2D_IRQn 1 */
-
+  TRACE_ISR_EXIT();
   /* USER CODE END DMA2D_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles HASH and RNG global interrupt.
+  */
+void HASH_RNG_IRQHandler(void)
+{
+  TRACE_ISR_ENTER();
+  HAL_RNG_IRQHandler(&hrng);
+  TRACE_ISR_EXIT();
+}
+
+/**
+  * @brief This function handles DMA2 stream1 global interrupt (audio mixer).
+  */
+RAM_FUNC void DMA2_Stream1_IRQHandler(void)
+{
+  TRACE_ISR_ENTER();
+  AudioMixer_DMA_IRQHandler();
+  TRACE_ISR_EXIT();
+}
+
+/**
+  * @brief This function handles DMA1 stream2 global interrupt (touch FIFO reads).
+  */
+void DMA1_Stream2_IRQHandler(void)
+{
+  TRACE_ISR_ENTER();
+  TouchSampler_DMA_IRQHandler();
+  TRACE_ISR_EXIT();
+}
+
+/**
+  * @brief This function handles I2C3 event interrupt (touch controller).
+  */
+void I2C3_EV_IRQHandler(void)
+{
+  TRACE_ISR_ENTER();
+  HAL_I2C_EV_IRQHandler(&hi2c3);
+  TRACE_ISR_EXIT();
+}
+
+/**
+  * @brief This function handles I2C3 error interrupt (touch controller).
+  */
+void I2C3_ER_IRQHandler(void)
+{
+  TRACE_ISR_ENTER();
+  HAL_I2C_ER_IRQHandler(&hi2c3);
+  TRACE_ISR_EXIT();
+}
+
+/**
+  * @brief This function handles DMA2 stream4 global interrupt (LCD commands).
+  */
+void DMA2_Stream4_IRQHandler(void)
+{
+  TRACE_ISR_ENTER();
+  LcdCommand_DMA_IRQHandler();
+  TRACE_ISR_EXIT();
+}
+
+/**
+  * @brief This function handles USART1 global interrupt (profiler dump).
+  */
+void USART1_IRQHandler(void)
+{
+  TRACE_ISR_ENTER();
+  HAL_UART_IRQHandler(&huart1);
+  TRACE_ISR_EXIT();
+}
+
 /* USER CODE END 1 */
@@ -0,0 +1,64 @@
+#ifndef DIGIT_DISPLAY_HPP
+#define DIGIT_DISPLAY_HPP
+
+#include <touchgfx/widgets/Widget.hpp>
+#include <touchgfx/TypedText.hpp>
+#include <touchgfx/hal/Types.hpp>
+
+/**
+ * Fixed-width, zero-padded number drawn from pre-rendered digit cells.
+ *
+ * The glyphs '0'-'9' of a font are rasterized once into an 8-bit alpha
+ * strip (ten equal cells, shared by every display using that font). A value
+ * is then drawn by blitting one cell per digit (DMA2D A8 blend in the
+ * display colour), with no string formatting, glyph lookup or text layout.
+ * setValue() invalidates only the digits that changed.
+ */
+class DigitDisplay : public touchgfx::Widget
+{
+public:
+    static const uint8_t MAX_DIGITS = 8;
+
+    DigitDisplay();
+
+    // Font of the typed text, number of digits ("%0Nd"); centred in the widget width
+    void setup(touchgfx::TypedTextId typedText, uint8_t digits);
+
+    void setValue(int32_t value); // Clamped to 0 .. 10^digits - 1
+    int32_t getValue() const { return value; }
+
+    void setColor(touchgfx::colortype newColor);
+    touchgfx::colortype getColor() const { return color; }
+
+    virtual void draw(const touchgfx::Rect& invalidatedArea) const;
+    virtual touchgfx::Rect getSolidRect() const { return touchgfx::Rect(); }
+
+private:
+    struct Strip
+    {
+        touchgfx::FontId font;
+        uint16_t cellWidth;
+        uint16_t cellHeight;
+        const uint8_t* pixels; // 10 cells side by side, stride 10 * cellWidth
+    };
+
+    static const uint8_t MAX_STRIPS = 2;
+    static const uint16_t STRIP_BYTES = 1536; // Per font; the 10 px digits need ~900
+
+    static Strip strips[MAX_STRIPS];
+    static uint8_t stripPixels[MAX_STRIPS][STRIP_BYTES];
+    static uint8_t stripCount;
+
+    static const Strip* getStrip(touchgfx::TypedTextId typedText);
+
+    const Strip* strip;
+    uint8_t digitCount;
+    uint8_t digits[MAX_DIGITS]; // Most significant first
+    int32_t value;
+    touchgfx::colortype color;
+
+    touchgfx::Rect getCellRect(uint8_t index) const;
+    void drawCell(uint8_t digit, const touchgfx::Rect& area, int16_t cellX) const;
+};
+
+#endif // DIGIT_DISPLAY_HPP
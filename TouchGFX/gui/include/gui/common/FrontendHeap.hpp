@@ -2,6 +2,11 @@
 #define FRONTENDHEAP_HPP
 
 #include <gui_generated/common/FrontendHeapBase.hpp>
+#ifndef SIMULATOR
+#include "CcmRam.h"
+#else
+#define CCM_BSS
+#endif
 
 class FrontendHeap : public FrontendHeapBase
 {
@@ -53,7 +58,10 @@ public:
 
     static FrontendHeap& getInstance()
     {
-        static FrontendHeap instance;
+        // Model, presenters and the widget tree live in CCM: the game logic and
+        // every render pass walk them without waiting behind LTDC/DMA2D. Only
+        // the CPU reads widgets; bitmaps and framebuffers stay where DMA2D sees them.
+        static FrontendHeap instance CCM_BSS;
         return instance;
     }
 
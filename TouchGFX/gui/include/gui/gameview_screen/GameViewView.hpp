@@ -3,6 +3,7 @@
 
 #include <gui_generated/gameview_screen/GameViewViewBase.hpp>
 #include <gui/gameview_screen/GameViewPresenter.hpp>
+#include <gui/common/DigitDisplay.hpp>
 #include <touchgfx/widgets/Box.hpp>
 #include <touchgfx/containers/Container.hpp>
 #include <touchgfx/widgets/Image.hpp>
@@ -42,12 +43,10 @@ protected:
     touchgfx::TextArea holdLabel;
     
     touchgfx::TextArea levelLabel;
-    touchgfx::TextAreaWithOneWildcard levelValue;
-    touchgfx::Unicode::UnicodeChar levelBuffer[8];
+    DigitDisplay levelValue;
 
     touchgfx::TextArea linesLabel;
-    touchgfx::TextAreaWithOneWildcard linesValue;
-    touchgfx::Unicode::UnicodeChar linesBuffer[8];
+    DigitDisplay linesValue;
 
     // Right Sidebar
     touchgfx::Image nextPanel;
@@ -57,12 +56,10 @@ protected:
     touchgfx::TextArea scoreLabel;
     
     // 4 Score Lines (1 Current + 3 HighScores)
-    touchgfx::TextAreaWithOneWildcard scoreLines[4];
-    touchgfx::Unicode::UnicodeChar scoreBuffers[4][12];
+    DigitDisplay scoreLines[4];
 
     touchgfx::TextArea goalLabel;
-    touchgfx::TextAreaWithOneWildcard goalValue;
-    touchgfx::Unicode::UnicodeChar goalBuffer[8];
+    DigitDisplay goalValue;
 
     touchgfx::TextArea gameOverLabel;
     touchgfx::TextArea pausedLabel;
@@ -93,6 +90,10 @@ protected:
     touchgfx::BitmapId blockBitmaps[Tetris::COUNT];
 
     void drawPiece(Tetris::TetrominoType type, int x, int y, int rotation, touchgfx::Image* blockArray, int offsetX, int offsetY, bool isRelative = false);
+
+    // Precise invalidation: these only invalidate what actually changed
+    void placeBlock(touchgfx::Image& block, touchgfx::BitmapId bmp, int x, int y, bool visible);
+    void setVisibleTracked(touchgfx::Drawable& drawable, bool visible);
 };
 
 #endif // GAMEVIEWVIEW_HPP
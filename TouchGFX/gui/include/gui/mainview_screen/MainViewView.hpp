@@ -49,6 +49,23 @@ protected:
     touchgfx::Box closeBtnRec;
     touchgfx::TextAreaWithOneWildcard closeBtnLabel;
 
+    // Profiler Debug Screen (tap the logo)
+    static const int DEBUG_LINES = 12;
+    touchgfx::Container debugModal;
+    touchgfx::Box debugBackground;
+    touchgfx::TextAreaWithOneWildcard debugLines[DEBUG_LINES];
+    touchgfx::Unicode::UnicodeChar debugBuffers[DEBUG_LINES][40];
+    touchgfx::TextAreaWithOneWildcard debugCalibLabel;
+    uint32_t debugSequence;
+
+    // Touch Calibration (bottom of the debug screen)
+    touchgfx::Container calibModal;
+    touchgfx::Box calibBackground;
+    touchgfx::Box calibCross[2]; // Horizontal, Vertical
+    touchgfx::TextAreaWithOneWildcard calibText;
+    touchgfx::Unicode::UnicodeChar calibBuffer[40];
+    int calibShown; // Step or result on screen, -1 = none yet
+
     // Decoration (optional but nice)
     touchgfx::Image backgroundBlocks[10];
     int backgroundBlockSpeeds[10];
@@ -56,6 +73,11 @@ protected:
     void setupButton(touchgfx::Container& btn, touchgfx::Box& bg, touchgfx::Box* borders, touchgfx::TextArea& label, TypedTextId textId, int x, int y);
     void showHighScoreModal();
     void hideHighScoreModal();
+    void setupDebugModal();
+    void updateDebugModal();
+    void setupCalibModal();
+    void startCalibration();
+    void updateCalibModal();
 };
 
 #endif // MAINVIEWVIEW_HPP
@@ -2,6 +2,7 @@
 #define MODEL_HPP
 
 #include <gui/common/TetrisDefinitions.hpp>
+#include <stdint.h>
 
 class ModelListener;
 
@@ -47,6 +48,13 @@ public:
     void getHighScores(int* buffer) const;
     void addScore(int newScore);
 
+    // Frame pacing: ticks that notified the view vs. ticks with nothing to draw
+    uint32_t getFramesRendered() const { return framesRendered; }
+    uint32_t getFramesSkipped() const { return framesSkipped; }
+
+    // Power: the game screen renders at full rate while a game is running
+    void setGameScreenActive(bool active) { gameScreenActive = active; stateChanged = true; }
+
 protected:
     int highScores[3];
     ModelListener* modelListener;
@@ -71,11 +79,20 @@ protected:
     int tickCounter;
     int dropSpeed; // Ticks per drop
 
+    bool stateChanged; // Set by anything the view shows, consumed by tick()
+    uint32_t framesRendered;
+    uint32_t framesSkipped;
+
+    bool gameScreenActive;
+
     void spawnPiece();
     void lockPiece();
     void checkLines();
     bool isCollision(int x, int y, int rotation) const;
     Tetris::TetrominoType getRandomPiece();
+#ifndef SIMULATOR
+    void publishSnapshot() const; // GameSnapshot.h, for readers on other tasks
+#endif
 };
 
 #endif // MODEL_HPP
@@ -0,0 +1,234 @@
+#include <gui/common/DigitDisplay.hpp>
+#include <touchgfx/Font.hpp>
+#include <touchgfx/Color.hpp>
+#include <touchgfx/hal/HAL.hpp>
+
+using namespace touchgfx;
+
+DigitDisplay::Strip DigitDisplay::strips[DigitDisplay::MAX_STRIPS];
+uint8_t DigitDisplay::stripPixels[DigitDisplay::MAX_STRIPS][DigitDisplay::STRIP_BYTES];
+uint8_t DigitDisplay::stripCount = 0;
+
+DigitDisplay::DigitDisplay() :
+    strip(0),
+    digitCount(0),
+    value(0),
+    color(0)
+{
+    for (uint8_t i = 0; i < MAX_DIGITS; i++)
+    {
+        digits[i] = 0;
+    }
+}
+
+/* Finds or renders the digit strip of the typed text's font; 0 if it does not fit */
+const DigitDisplay::Strip* DigitDisplay::getStrip(TypedTextId typedText)
+{
+    const TypedText text(typedText);
+    const Font* font = text.getFont();
+    const FontId fontId = text.getFontId();
+    const GlyphNode* glyphs[10];
+    const uint8_t* glyphData[10];
+    uint8_t glyphBpp[10];
+    uint16_t cellWidth = 0;
+    uint16_t cellHeight = font->getFontHeight();
+    uint8_t c;
+
+    for (uint8_t i = 0; i < stripCount; i++)
+    {
+        if (strips[i].font == fontId)
+        {
+            return &strips[i];
+        }
+    }
+    if (stripCount >= MAX_STRIPS)
+    {
+        return 0;
+    }
+
+    for (c = 0; c < 10; c++)
+    {
+        glyphs[c] = font->getGlyph('0' + c, glyphData[c], glyphBpp[c]);
+        if (glyphs[c] != 0 && glyphs[c]->advance() > cellWidth)
+        {
+            cellWidth = glyphs[c]->advance();
+        }
+    }
+    if (cellWidth == 0 || 10U * cellWidth * cellHeight > STRIP_BYTES)
+    {
+        return 0;
+    }
+
+    Strip& entry = strips[stripCount];
+    uint8_t* pixels = stripPixels[stripCount];
+    const uint16_t stride = 10 * cellWidth;
+
+    for (uint32_t i = 0; i < (uint32_t)stride * cellHeight; i++)
+    {
+        pixels[i] = 0;
+    }
+
+    // Unpack each glyph into its cell: 1/2/4/8 bpp, first pixel in the low
+    // bits, rows byte aligned or not depending on the font
+    for (c = 0; c < 10; c++)
+    {
+        const GlyphNode* glyph = glyphs[c];
+        if (glyph == 0 || glyphData[c] == 0)
+        {
+            continue;
+        }
+
+        const uint8_t bpp = glyphBpp[c];
+        const uint8_t mask = (1U << bpp) - 1U;
+        const uint16_t rowBits = font->getByteAlignRow() ? ((glyph->width() * bpp + 7U) & ~7U) : glyph->width() * bpp;
+        const int16_t top = font->getBaseline() - glyph->top();
+
+        for (int16_t y = 0; y < glyph->height(); y++)
+        {
+            for (int16_t x = 0; x < glyph->width(); x++)
+            {
+                const int16_t px = glyph->left + x;
+                const int16_t py = top + y;
+                if (px < 0 || px >= (int16_t)cellWidth || py < 0 || py >= (int16_t)cellHeight)
+                {
+                    continue;
+                }
+
+                const uint32_t bit = (uint32_t)y * rowBits + (uint32_t)x * bpp;
+                const uint8_t level = (glyphData[c][bit >> 3] >> (bit & 7U)) & mask;
+                pixels[py * stride + c * cellWidth + px] = (uint8_t)((level * 255U) / mask);
+            }
+        }
+    }
+
+    entry.font = fontId;
+    entry.cellWidth = cellWidth;
+    entry.cellHeight = cellHeight;
+    entry.pixels = pixels;
+    stripCount++;
+    return &entry;
+}
+
+void DigitDisplay::setup(TypedTextId typedText, uint8_t count)
+{
+    strip = getStrip(typedText);
+    digitCount = (count > MAX_DIGITS) ? MAX_DIGITS : count;
+    value = -1; // Forces the first setValue() to fill in the digits
+    setValue(0);
+    invalidate();
+}
+
+void DigitDisplay::setValue(int32_t newValue)
+{
+    int32_t limit = 1;
+    for (uint8_t i = 0; i < digitCount; i++)
+    {
+        limit *= 10;
+    }
+    if (newValue < 0)
+    {
+        newValue = 0;
+    }
+    else if (newValue >= limit)
+    {
+        newValue = limit - 1;
+    }
+    if (newValue == value)
+    {
+        return;
+    }
+    value = newValue;
+
+    // Only the cells whose digit changed are redrawn
+    for (uint8_t i = digitCount; i-- > 0; )
+    {
+        const uint8_t digit = (uint8_t)(newValue % 10);
+        newValue /= 10;
+        if (digits[i] != digit)
+        {
+            digits[i] = digit;
+            Rect cell = getCellRect(i);
+            invalidateRect(cell);
+        }
+    }
+}
+
+void DigitDisplay::setColor(colortype newColor)
+{
+    if (color != newColor)
+    {
+        color = newColor;
+        invalidate();
+    }
+}
+
+Rect DigitDisplay::getCellRect(uint8_t index) const
+{
+    if (strip == 0)
+    {
+        return Rect();
+    }
+    const int16_t left = (getWidth() - digitCount * strip->cellWidth) / 2;
+    return Rect(left + index * strip->cellWidth, 0, strip->cellWidth, strip->cellHeight);
+}
+
+void DigitDisplay::draw(const Rect& invalidatedArea) const
+{
+    if (strip == 0)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < digitCount; i++)
+    {
+        const Rect cell = getCellRect(i);
+        Rect area = cell & invalidatedArea;
+        if (!area.isEmpty())
+        {
+            drawCell(digits[i], area, cell.x);
+        }
+    }
+}
+
+/* Blends the part 'area' (widget coordinates) of one digit cell onto the framebuffer */
+void DigitDisplay::drawCell(uint8_t digit, const Rect& area, int16_t cellX) const
+{
+    const uint16_t stride = 10 * strip->cellWidth;
+    const uint8_t* src = strip->pixels + area.y * stride + digit * strip->cellWidth + (area.x - cellX);
+    Rect absolute = area;
+    translateRectToAbsolute(absolute);
+
+    if (HAL::getInstance()->getBlitCaps() & BLIT_OP_COPY_A8)
+    {
+        HAL::getInstance()->blitCopyGlyph(src, absolute.x, absolute.y, absolute.width, absolute.height,
+                                          stride, color, 255, BLIT_OP_COPY_A8);
+        return;
+    }
+
+    // No DMA2D (simulator): blend on the CPU, RGB565 framebuffer
+    const uint32_t r = Color::getRed(color);
+    const uint32_t g = Color::getGreen(color);
+    const uint32_t b = Color::getBlue(color);
+    uint16_t* fb = HAL::getInstance()->lockFrameBuffer();
+
+    for (int16_t y = 0; y < absolute.height; y++)
+    {
+        uint16_t* dst = fb + (absolute.y + y) * HAL::FRAME_BUFFER_WIDTH + absolute.x;
+        for (int16_t x = 0; x < absolute.width; x++)
+        {
+            const uint32_t a = src[y * stride + x];
+            if (a == 0)
+            {
+                continue;
+            }
+            const uint32_t bgR = (dst[x] >> 8) & 0xF8U;
+            const uint32_t bgG = (dst[x] >> 3) & 0xFCU;
+            const uint32_t bgB = (dst[x] << 3) & 0xF8U;
+            const uint32_t outR = (r * a + bgR * (255U - a)) / 255U;
+            const uint32_t outG = (g * a + bgG * (255U - a)) / 255U;
+            const uint32_t outB = (b * a + bgB * (255U - a)) / 255U;
+            dst[x] = (uint16_t)(((outR & 0xF8U) << 8) | ((outG & 0xFCU) << 3) | (outB >> 3));
+        }
+    }
+    HAL::getInstance()->unlockFrameBuffer();
+}
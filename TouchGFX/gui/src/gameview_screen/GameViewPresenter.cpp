@@ -10,11 +10,12 @@ GameViewPresenter::GameViewPresenter(GameViewView& v)
 void GameViewPresenter::activate()
 {
     model->resetGame();
+    model->setGameScreenActive(true);
 }
 
 void GameViewPresenter::deactivate()
 {
-
+    model->setGameScreenActive(false);
 }
 
 void GameViewPresenter::modelStateChanged()
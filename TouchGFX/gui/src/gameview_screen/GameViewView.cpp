@@ -6,6 +6,12 @@ extern "C" {
     #include "SoundEngine.h"
 }
 
+#ifndef SIMULATOR
+extern "C" {
+    #include "TouchGesture.h"
+}
+#endif
+
 GameViewView::GameViewView() :
     lastLines(0),
     wasGameOver(false)
@@ -20,6 +26,12 @@ void GameViewView::setupScreen()
     // Start Game Theme
     SoundEngine_PlayTrack(TRACK_GAME_THEME_A);
 
+#ifndef SIMULATOR
+    // Drag = move, drag down = soft drop, flick down = hard drop, tap = rotate.
+    // Everything above the Pause/Menu buttons (y = 288) is touch controls
+    TouchGesture_Enable(0, 0, 240, 284);
+#endif
+
     // Initial State
     lastLines = presenter->getLines();
     wasGameOver = presenter->getIsGameOver();
@@ -91,13 +103,12 @@ void GameViewView::setupScreen()
     levelLabel.setColor(touchgfx::Color::getColorFromRGB(0xFF, 0xFF, 0xFF));
     add(levelLabel);
 
-    levelValue.setTypedText(touchgfx::TypedText(T_WILDCARD));
     levelValue.setXY(0, 140);
     levelValue.setWidth(60);
     levelValue.setHeight(20);
+    levelValue.setup(T_WILDCARD, 2);
     levelValue.setColor(touchgfx::Color::getColorFromRGB(0x00, 0xFF, 0x41)); // Neon Green
-    Unicode::snprintf(levelBuffer, 8, "01");
-    levelValue.setWildcard(levelBuffer);
+    levelValue.setValue(1);
     add(levelValue);
 
     // LINES
@@ -107,13 +118,11 @@ void GameViewView::setupScreen()
     linesLabel.setColor(touchgfx::Color::getColorFromRGB(0xFF, 0xFF, 0xFF));
     add(linesLabel);
 
-    linesValue.setTypedText(touchgfx::TypedText(T_WILDCARD));
     linesValue.setXY(0, 250);
     linesValue.setWidth(60);
     linesValue.setHeight(20);
+    linesValue.setup(T_WILDCARD, 3);
     linesValue.setColor(touchgfx::Color::getColorFromRGB(0x00, 0xFB, 0xFF)); // Neon Cyan
-    Unicode::snprintf(linesBuffer, 8, "000");
-    linesValue.setWildcard(linesBuffer);
     add(linesValue);
 
     // 6. Right Sidebar (180-240px)
@@ -142,15 +151,12 @@ void GameViewView::setupScreen()
     // Score Lines (Start Y = 126, Spacing = 16)
     for(int i=0; i<4; i++)
     {
-        scoreLines[i].setTypedText(touchgfx::TypedText(T_WILDCARD));
         scoreLines[i].setXY(180, 126 + (i * 16));
         scoreLines[i].setWidth(60);
         scoreLines[i].setHeight(16); // Compact height
+        scoreLines[i].setup(T_WILDCARD, 6);
         // Color will be set in updateBoard based on ranking
         scoreLines[i].setColor(touchgfx::Color::getColorFromRGB(0x80, 0x80, 0x80)); // Default Gray
-        
-        Unicode::snprintf(scoreBuffers[i], 12, "000000");
-        scoreLines[i].setWildcard(scoreBuffers[i]);
         add(scoreLines[i]);
     }
 
@@ -161,13 +167,12 @@ void GameViewView::setupScreen()
     goalLabel.setColor(touchgfx::Color::getColorFromRGB(0xFF, 0xFF, 0xFF));
     add(goalLabel);
 
-    goalValue.setTypedText(touchgfx::TypedText(T_WILDCARD));
     goalValue.setXY(180, 250);
     goalValue.setWidth(60);
     goalValue.setHeight(20);
+    goalValue.setup(T_WILDCARD, 3);
     goalValue.setColor(touchgfx::Color::getColorFromRGB(0xFF, 0x00, 0x3C)); // Neon Red
-    Unicode::snprintf(goalBuffer, 8, "010");
-    goalValue.setWildcard(goalBuffer);
+    goalValue.setValue(10);
     add(goalValue);
 
     // 7. Header (Top 40px)
@@ -247,6 +252,8 @@ void GameViewView::setupScreen()
     add(pausedLabel);
 
     // 10. Initialize Block Bitmaps mapping
+    // The block images are L8 with an ARGB8888 palette (application.config):
+    // DMA2D loads the 2-3 entry CLUT and then reads 1 byte per pixel instead of 4
     blockBitmaps[Tetris::I] = BITMAP_BLOCK_I_ID;
     blockBitmaps[Tetris::J] = BITMAP_BLOCK_J_ID;
     blockBitmaps[Tetris::L] = BITMAP_BLOCK_L_ID;
@@ -307,16 +314,9 @@ void GameViewView::updateBoard()
         for (int x = 0; x < MATRIX_COLS; x++)
         {
             signed char type = presenter->getGridValue(x, y);
-            if (type >= 0 && type < Tetris::COUNT)
-            {
-                fixedBlocks[y][x].setBitmap(touchgfx::Bitmap(blockBitmaps[type]));
-                fixedBlocks[y][x].setVisible(true);
-            }
-            else
-            {
-                fixedBlocks[y][x].setVisible(false);
-            }
-            fixedBlocks[y][x].invalidate();
+            bool filled = (type >= 0 && type < Tetris::COUNT);
+            placeBlock(fixedBlocks[y][x], filled ? blockBitmaps[type] : touchgfx::BITMAP_INVALID,
+                       2 + x * CELL_SIZE, 2 + y * CELL_SIZE, filled);
         }
     }
 
@@ -336,7 +336,7 @@ void GameViewView::updateBoard()
         }
         else
         {
-            for (int i = 0; i < 4; i++) ghostBlocks[i].setVisible(false);
+            for (int i = 0; i < 4; i++) setVisibleTracked(ghostBlocks[i], false);
         }
 
         // Draw Falling Piece
@@ -350,8 +350,8 @@ void GameViewView::updateBoard()
     {
         for (int i = 0; i < 4; i++)
         {
-            fallingBlocks[i].setVisible(false);
-            ghostBlocks[i].setVisible(false);
+            setVisibleTracked(fallingBlocks[i], false);
+            setVisibleTracked(ghostBlocks[i], false);
         }
     }
 
@@ -373,7 +373,7 @@ void GameViewView::updateBoard()
     }
     else
     {
-        for (int i = 0; i < 4; i++) holdBlocks[i].setVisible(false);
+        for (int i = 0; i < 4; i++) setVisibleTracked(holdBlocks[i], false);
     }
 
     // Update Sidebars (Score, Level, Lines, Goal)
@@ -389,65 +389,77 @@ void GameViewView::updateBoard()
 
     for(int i=0; i<4; i++)
     {
-        Unicode::snprintf(scoreBuffers[i], 12, "%06d", scoreboard[i].score);
-        
-        if (scoreboard[i].isCurrent)
-        {
-            // Yellow for user
-             scoreLines[i].setColor(touchgfx::Color::getColorFromRGB(0xFF, 0xD5, 0x00));
-        }
-        else
-        {
-            // Gray for others
-             scoreLines[i].setColor(touchgfx::Color::getColorFromRGB(0x80, 0x80, 0x80));
-        }
-        scoreLines[i].invalidate();
-    }
+        scoreLines[i].setValue(scoreboard[i].score);
 
-    Unicode::snprintf(levelBuffer, 8, "%02d", presenter->getLevel());
-    levelValue.invalidate();
+        // Yellow for user, Gray for others (setColor redraws only on a change)
+        scoreLines[i].setColor(scoreboard[i].isCurrent ?
+            touchgfx::Color::getColorFromRGB(0xFF, 0xD5, 0x00) :
+            touchgfx::Color::getColorFromRGB(0x80, 0x80, 0x80));
+    }
 
-    Unicode::snprintf(linesBuffer, 8, "%03d", presenter->getLines());
-    linesValue.invalidate();
+    // Digit displays: no formatting, only changed digits are redrawn
+    levelValue.setValue(presenter->getLevel());
+    linesValue.setValue(presenter->getLines());
 
     // Goal is next level requirement (Level * 10)
-    Unicode::snprintf(goalBuffer, 8, "%03d", presenter->getLevel() * 10);
-    goalValue.invalidate();
+    goalValue.setValue(presenter->getLevel() * 10);
 
     // Handle Game Over
-    // Handle Game Over
-    if (presenter->getIsGameOver())
-    {
-        if (!wasGameOver) {
-            SoundEngine_PlayTrack(TRACK_GAME_OVER);
-            wasGameOver = true;
-        }
+    bool gameOver = presenter->getIsGameOver();
+    // Handle Pause logic only if not Game Over
+    bool paused = !gameOver && presenter->getIsPaused();
 
-        gameOverLabel.setVisible(true);
-        Unicode::snprintf(pauseButtonBuffer, 10, "RESET");
-        pauseButton.setTypedText(touchgfx::TypedText(T_WILDCARD));
+    if (gameOver && !wasGameOver)
+    {
+        SoundEngine_PlayTrack(TRACK_GAME_OVER);
     }
-    else
+    wasGameOver = gameOver; // Reset trigger if restarted
+
+    setVisibleTracked(gameOverLabel, gameOver);
+    setVisibleTracked(pausedLabel, paused);
+
+    touchgfx::TypedTextId buttonText = gameOver ? T_WILDCARD : (paused ? T_RESUME : T_PAUSE);
+    if (pauseButton.getTypedText().getId() != buttonText)
     {
-        wasGameOver = false; // Reset trigger if restarted
-        gameOverLabel.setVisible(false);
-        // Handle Pause logic only if not Game Over
-        if (presenter->getIsPaused())
-        {
-            pausedLabel.setVisible(true);
-            pauseButton.setTypedText(touchgfx::TypedText(T_RESUME));
-        }
-        else
+        if (gameOver)
         {
-            pausedLabel.setVisible(false);
-            pauseButton.setTypedText(touchgfx::TypedText(T_PAUSE));
+            Unicode::snprintf(pauseButtonBuffer, 10, "RESET");
         }
+        pauseButton.setTypedText(touchgfx::TypedText(buttonText));
+        pauseButton.invalidate();
+    }
+
+    // No screen-wide invalidate(): only widgets whose content changed were
+    // invalidated above, so an idle frame renders nothing.
+}
+
+/* Moves/shows/hides a block, invalidating its old and new area only if something changed */
+void GameViewView::placeBlock(touchgfx::Image& block, touchgfx::BitmapId bmp, int x, int y, bool visible)
+{
+    if (block.isVisible() == visible &&
+        (!visible || (block.getBitmap() == bmp && block.getX() == x && block.getY() == y)))
+    {
+        return;
+    }
+
+    block.invalidate(); // Old area (no-op while hidden)
+    if (visible)
+    {
+        block.setBitmap(touchgfx::Bitmap(bmp));
+        block.setXY(x, y);
     }
-    gameOverLabel.invalidate();
-    pausedLabel.invalidate();
-    pauseButton.invalidate();
+    block.setVisible(visible);
+    block.invalidate(); // New area
+}
 
-    invalidate();
+void GameViewView::setVisibleTracked(touchgfx::Drawable& drawable, bool visible)
+{
+    if (drawable.isVisible() != visible)
+    {
+        drawable.invalidate();
+        drawable.setVisible(visible);
+        drawable.invalidate();
+    }
 }
 
 void GameViewView::drawPiece(Tetris::TetrominoType type, int x, int y, int rotation, touchgfx::Image* blockArray, int offsetX, int offsetY, bool isRelative)
@@ -463,10 +475,7 @@ void GameViewView::drawPiece(Tetris::TetrominoType type, int x, int y, int rotat
             {
                 if (blockIdx < 4)
                 {
-                    blockArray[blockIdx].setBitmap(touchgfx::Bitmap(bmp));
-                    blockArray[blockIdx].setXY(offsetX + (x + col) * 12, offsetY + (y + row) * 12);
-                    blockArray[blockIdx].setVisible(true);
-                    blockArray[blockIdx].invalidate();
+                    placeBlock(blockArray[blockIdx], bmp, offsetX + (x + col) * 12, offsetY + (y + row) * 12, true);
                     blockIdx++;
                 }
             }
@@ -476,13 +485,15 @@ void GameViewView::drawPiece(Tetris::TetrominoType type, int x, int y, int rotat
     // Hide unused blocks if any (shouldn't happen with 4 blocks)
     for (; blockIdx < 4; blockIdx++)
     {
-        blockArray[blockIdx].setVisible(false);
-        blockArray[blockIdx].invalidate();
+        setVisibleTracked(blockArray[blockIdx], false);
     }
 }
 
 void GameViewView::tearDownScreen()
 {
+#ifndef SIMULATOR
+    TouchGesture_Disable();
+#endif
     GameViewViewBase::tearDownScreen();
 }
 
@@ -523,7 +534,7 @@ void GameViewView::handleKeyEvent(uint8_t key)
         break;
     }
 
-    updateBoard();
+    // The model flags the change; the next tick redraws what moved
 }
 
 void GameViewView::handleClickEvent(const touchgfx::ClickEvent& event)
@@ -543,7 +554,6 @@ void GameViewView::handleClickEvent(const touchgfx::ClickEvent& event)
             {
                  presenter->togglePause();
             }
-            updateBoard();
         }
 
         // Check if click is within Menu button container
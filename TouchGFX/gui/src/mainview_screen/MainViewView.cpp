@@ -5,21 +5,26 @@
 #include <gui/common/FrontendApplication.hpp>
 #include <touchgfx/TypedText.hpp>
 #include <cstdlib>
+#include <cstdio>
 
 #ifndef SIMULATOR
 #include "main.h"
 
 extern "C" {
-    extern RNG_HandleTypeDef hrng;
+    #include "EntropyPool.h"
     #include "SoundEngine.h"
+    #include "PowerManager.h"
+    #include "Profiler.h"
+    #include "MemoryMonitor.h"
+    #include "TouchCalib.h"
 }
 
 static int getRandom(int max) {
     uint32_t val = 0;
-    if (HAL_RNG_GenerateRandomNumber(&hrng, &val) == HAL_OK) {
+    if (EntropyPool_Take(&val)) {
         return val % max;
     }
-    return 0;
+    return rand() % max; // Pool drained, never stall the animation
 }
 #else
 static int getRandom(int max) {
@@ -27,7 +32,9 @@ static int getRandom(int max) {
 }
 #endif
 
-MainViewView::MainViewView()
+MainViewView::MainViewView() :
+    debugSequence(0),
+    calibShown(-1)
 {
 
 }
@@ -134,6 +141,9 @@ void MainViewView::setupScreen()
     highScoreModal.add(closeBtn);
 
     add(highScoreModal);
+
+    setupDebugModal();
+    setupCalibModal();
 }
 
 void MainViewView::handleTickEvent()
@@ -143,9 +153,16 @@ void MainViewView::handleTickEvent()
         BITMAP_BLOCK_O_ID, BITMAP_BLOCK_S_ID, BITMAP_BLOCK_T_ID, BITMAP_BLOCK_Z_ID
     };
 
+#ifndef SIMULATOR
+    // Ticks come less often at the low render rate; keep the fall speed
+    const int frameStep = PowerManager_GetFrameInterval();
+#else
+    const int frameStep = 1;
+#endif
+
     for (int i = 0; i < 10; i++)
     {
-        backgroundBlocks[i].moveRelative(0, backgroundBlockSpeeds[i]);
+        backgroundBlocks[i].moveRelative(0, backgroundBlockSpeeds[i] * frameStep);
         if (backgroundBlocks[i].getY() > 320)
         {
             // Reset to a random negative Y to create a "disappear and spawn new" effect
@@ -156,6 +173,16 @@ void MainViewView::handleTickEvent()
         }
         backgroundBlocks[i].invalidate();
     }
+
+    if (debugModal.isVisible())
+    {
+        updateDebugModal();
+    }
+
+    if (calibModal.isVisible())
+    {
+        updateCalibModal();
+    }
 }
 
 void MainViewView::setupButton(touchgfx::Container& btn, touchgfx::Box& bg, touchgfx::Box* borders, touchgfx::TextArea& label, TypedTextId textId, int x, int y)
@@ -206,10 +233,209 @@ void MainViewView::hideHighScoreModal()
     highScoreModal.invalidate();
 }
 
+void MainViewView::setupDebugModal()
+{
+    debugModal.setPosition(0, 0, 240, 320);
+    debugModal.setVisible(false);
+
+    debugBackground.setPosition(0, 0, 240, 320);
+    debugBackground.setColor(touchgfx::Color::getColorFromRGB(0x00, 0x00, 0x00));
+    debugModal.add(debugBackground);
+
+    for (int i = 0; i < DEBUG_LINES; i++)
+    {
+        debugLines[i].setTypedText(touchgfx::TypedText(T_WILDCARD));
+        debugLines[i].setXY(0, 10 + (i * 18));
+        debugLines[i].setWidth(240);
+        debugLines[i].setColor(touchgfx::Color::getColorFromRGB(0xFF, 0xFF, 0xFF));
+        debugBuffers[i][0] = 0;
+        debugLines[i].setWildcard(debugBuffers[i]);
+        debugModal.add(debugLines[i]);
+    }
+    debugLines[0].setColor(touchgfx::Color::getColorFromRGB(0xFF, 0xD5, 0x00)); // Gold
+
+#ifndef SIMULATOR
+    static touchgfx::Unicode::UnicodeChar calibLabelStatic[40];
+    Unicode::strncpy(calibLabelStatic, "TAP HERE TO CALIBRATE TOUCH", 40);
+    debugCalibLabel.setTypedText(touchgfx::TypedText(T_WILDCARD));
+    debugCalibLabel.setWildcard(calibLabelStatic);
+    debugCalibLabel.setXY(0, 290);
+    debugCalibLabel.setWidth(240);
+    debugCalibLabel.setColor(touchgfx::Color::getColorFromRGB(0x00, 0xF0, 0xFF)); // Cyan
+    debugModal.add(debugCalibLabel);
+#endif
+
+    add(debugModal);
+}
+
+void MainViewView::setupCalibModal()
+{
+    calibModal.setPosition(0, 0, 240, 320);
+    calibModal.setVisible(false);
+
+    calibBackground.setPosition(0, 0, 240, 320);
+    calibBackground.setColor(touchgfx::Color::getColorFromRGB(0x00, 0x00, 0x00));
+    calibModal.add(calibBackground);
+
+    for (int i = 0; i < 2; i++)
+    {
+        calibCross[i].setColor(touchgfx::Color::getColorFromRGB(0xFF, 0xFF, 0xFF));
+        calibModal.add(calibCross[i]);
+    }
+
+    calibText.setTypedText(touchgfx::TypedText(T_WILDCARD));
+    calibText.setXY(0, 140);
+    calibText.setWidth(240);
+    calibText.setColor(touchgfx::Color::getColorFromRGB(0xFF, 0xD5, 0x00)); // Gold
+    calibBuffer[0] = 0;
+    calibText.setWildcard(calibBuffer);
+    calibModal.add(calibText);
+
+    add(calibModal);
+}
+
+void MainViewView::startCalibration()
+{
+#ifndef SIMULATOR
+    TouchCalib_Start();
+    calibShown = -1;
+    updateCalibModal();
+    calibModal.setVisible(true);
+    calibModal.invalidate();
+#endif
+}
+
+void MainViewView::updateCalibModal()
+{
+#ifndef SIMULATOR
+    // Targets and results change only on a tap; redraw just then
+    TouchCalib_State state = TouchCalib_GetState();
+    int shown = (state == TOUCHCAL_RUNNING) ? TouchCalib_GetStep() : TOUCHCAL_POINTS + state;
+    if (shown == calibShown)
+    {
+        return;
+    }
+    calibShown = shown;
+
+    if (state == TOUCHCAL_RUNNING)
+    {
+        char line[40];
+        uint16_t x, y;
+        TouchCalib_GetTarget(TouchCalib_GetStep(), &x, &y);
+        calibCross[0].setPosition(x - 10, y, 21, 1);
+        calibCross[1].setPosition(x, y - 10, 1, 21);
+        calibCross[0].setVisible(true);
+        calibCross[1].setVisible(true);
+
+        snprintf(line, sizeof(line), "TOUCH THE CROSS  %d/%u", TouchCalib_GetStep() + 1, (unsigned)TOUCHCAL_POINTS);
+        Unicode::strncpy(calibBuffer, line, 40);
+        calibText.setY((y < 160) ? 200 : 100); // Keep the text away from the target
+    }
+    else
+    {
+        calibCross[0].setVisible(false);
+        calibCross[1].setVisible(false);
+        calibText.setY(140);
+
+        if (state == TOUCHCAL_SAVED)
+        {
+            Unicode::strncpy(calibBuffer, "SAVED - TAP TO CLOSE", 40);
+        }
+        else if (state == TOUCHCAL_UNSAVED)
+        {
+            Unicode::strncpy(calibBuffer, "FLASH ERROR - NOT SAVED", 40);
+        }
+        else
+        {
+            Unicode::strncpy(calibBuffer, "FAILED - TAP TO CLOSE", 40);
+        }
+    }
+    calibModal.invalidate();
+#endif
+}
+
+void MainViewView::updateDebugModal()
+{
+    char line[40];
+    int row = 0;
+
+#ifndef SIMULATOR
+    static Profiler_Report report; // Too large for the GUI stack frame
+    if (Profiler_GetReport(&report) == debugSequence)
+    {
+        return; // Refreshed once per profiler window
+    }
+    debugSequence = report.sequence;
+
+    snprintf(line, sizeof(line), "PROFILER  %lu ms  %lu sw",
+             (unsigned long)(report.windowUs / 1000), (unsigned long)report.switches);
+    Unicode::strncpy(debugBuffers[row++], line, 40);
+
+    static MemoryMonitor_Report memory;
+    MemoryMonitor_GetReport(&memory);
+    snprintf(line, sizeof(line), "HEAP  %lu free  %lu min  frag %u%%",
+             (unsigned long)memory.heapFree, (unsigned long)memory.heapMinEverFree,
+             memory.fragmentationPermille / 10);
+    Unicode::strncpy(debugBuffers[row++], line, 40);
+
+    Unicode::strncpy(debugBuffers[row++], "TASK  CPU  STACK FREE  SW", 40);
+
+    for (int i = 0; i < report.taskCount && row < DEBUG_LINES; i++)
+    {
+        const Profiler_TaskInfo& t = report.tasks[i];
+        snprintf(line, sizeof(line), "%s  %u.%u%%  %luB  %lu", t.name,
+                 t.cpuPermille / 10, t.cpuPermille % 10,
+                 (unsigned long)t.stackFreeBytes, (unsigned long)t.switches);
+        Unicode::strncpy(debugBuffers[row++], line, 40);
+    }
+#else
+    if (debugSequence != 0)
+    {
+        return;
+    }
+    debugSequence = 1;
+
+    snprintf(line, sizeof(line), "PROFILER");
+    Unicode::strncpy(debugBuffers[row++], line, 40);
+    Unicode::strncpy(debugBuffers[row++], "n/a in simulator", 40);
+#endif
+
+    while (row < DEBUG_LINES)
+    {
+        debugBuffers[row++][0] = 0;
+    }
+    debugModal.invalidate();
+}
+
 void MainViewView::handleClickEvent(const touchgfx::ClickEvent& event)
 {
     if (event.getType() == touchgfx::ClickEvent::RELEASED)
     {
+        // Calibration gets no clicks while it runs; any tap closes the result
+        if (calibModal.isVisible())
+        {
+            calibModal.setVisible(false);
+            invalidate();
+            return;
+        }
+
+        // Debug screen covers everything, any tap closes it
+        if (debugModal.isVisible())
+        {
+#ifndef SIMULATOR
+            // ...except the calibration line at the bottom
+            if (event.getY() >= 280)
+            {
+                debugModal.setVisible(false);
+                startCalibration();
+                return;
+            }
+#endif
+            debugModal.setVisible(false);
+            invalidate();
+            return;
+        }
+
         // Check Modal interactions first if visible
         if (highScoreModal.isVisible())
         {
@@ -231,6 +457,16 @@ void MainViewView::handleClickEvent(const touchgfx::ClickEvent& event)
             static_cast<FrontendApplication*>(touchgfx::Application::getInstance())->gotoGameViewScreenNoTransition();
         }
 
+        // Logo opens the profiler debug screen
+        if (event.getX() >= logo.getX() && event.getX() < logo.getX() + logo.getWidth() &&
+            event.getY() >= logo.getY() && event.getY() < logo.getY() + logo.getHeight())
+        {
+            debugSequence = 0;
+            updateDebugModal();
+            debugModal.setVisible(true);
+            debugModal.invalidate();
+        }
+
         // HIGH SCORES Button click check
         if (event.getX() >= 40 && event.getX() <= 200 &&
             event.getY() >= 220 && event.getY() <= 260)
@@ -5,10 +5,17 @@
 #include "main.h"
 
 extern "C" {
-    extern RNG_HandleTypeDef hrng;
+    #include "EntropyPool.h"
+    #include "GameSnapshot.h"
+    #include "PowerManager.h"
 }
 #endif
 
+extern "C" {
+    #include "Trace.h" // Hooks are empty in the simulator
+    #include "RamFunc.h"
+}
+
 #include <cstdlib>
 #include <ctime>
 
@@ -17,7 +24,11 @@ extern osMessageQueueId_t inputQueueHandle;
 #endif
 
 Model::Model() : 
-    modelListener(0)
+    modelListener(0),
+    stateChanged(true),
+    framesRendered(0),
+    framesSkipped(0),
+    gameScreenActive(false)
 {
     // Hardcoded initial high scores
     highScores[0] = 5000;
@@ -56,10 +67,7 @@ void Model::resetGame()
     nextType = getRandomPiece();
     spawnPiece();
 
-    if (modelListener != 0)
-    {
-        modelListener->modelStateChanged();
-    }
+    stateChanged = true;
 }
 
 void Model::getHighScores(int* buffer) const
@@ -87,49 +95,119 @@ void Model::addScore(int newScore)
     }
 }
 
-void Model::tick()
+RAM_FUNC void Model::tick()
 {
-    if (isGameOver || isPaused)
-    {
-        return;
-    }
+    TRACE_EVENT(TRACE_EVT_GAME_TICK, framesRendered);
 
-    tickCounter++;
-    if (tickCounter >= dropSpeed)
+    if (!isGameOver && !isPaused)
     {
-        tickCounter = 0;
-        step();
-    }
+        tickCounter++;
+        if (tickCounter >= dropSpeed)
+        {
+            tickCounter = 0;
+            step();
+        }
     
 #ifndef SIMULATOR
-    uint8_t key = 0;
-    while (osMessageQueueGet(inputQueueHandle, &key, NULL, 0) == osOK)
-    {
-        switch (key)
+        uint8_t key = 0;
+        while (osMessageQueueGet(inputQueueHandle, &key, NULL, 0) == osOK)
         {
-            case 'U': rotate(); break;
-            case 'R': moveRight(); break;
-            case 'D': step(); break;
-            case 'L': moveLeft(); break;
-            case 'H': hardDrop(); break;
-            case 'S': holdPiece(); break;
-            default: break;
+            switch (key)
+            {
+                case 'U': rotate(); break;
+                case 'R': moveRight(); break;
+                case 'D': step(); break;
+                case 'L': moveLeft(); break;
+                case 'H': hardDrop(); break;
+                case 'S': holdPiece(); break;
+                default: break;
+            }
         }
+#endif
+    }
+
+#ifndef SIMULATOR
+    if (!gameScreenActive)
+    {
+        PowerManager_SetActivity(POWER_ACTIVITY_MENU);
+    }
+    else if (isGameOver || isPaused)
+    {
+        PowerManager_SetActivity(POWER_ACTIVITY_HALTED);
+    }
+    else
+    {
+        PowerManager_SetActivity(POWER_ACTIVITY_PLAYING);
     }
 #endif
 
+    // Only wake the view on frames where something visible changed; idle
+    // frames (paused, game over, between gravity steps) invalidate nothing
+    if (!stateChanged)
+    {
+        framesSkipped++;
+        return;
+    }
+
+    stateChanged = false;
+    framesRendered++;
+
+#ifndef SIMULATOR
+    // Other tasks read the game state from the snapshot, never from the model
+    publishSnapshot();
+#endif
+
     if (modelListener != 0)
     {
         modelListener->modelStateChanged();
     }
 }
 
+#ifndef SIMULATOR
+/* Packs the state other tasks may look at into one snapshot record */
+void Model::publishSnapshot() const
+{
+    GameSnapshot snapshot;
+
+    for (int y = 0; y < 20; y++)
+    {
+        uint16_t row = 0;
+        for (int x = 0; x < 10; x++)
+        {
+            if (grid[y][x] >= 0)
+            {
+                row |= (uint16_t)(1U << x);
+            }
+        }
+        snapshot.rows[y] = row;
+    }
+
+    snapshot.sequence = 0; // Set by GameSnapshot_Publish
+    snapshot.piece = (currentType == Tetris::NONE) ? GAMESNAPSHOT_NO_PIECE : (uint8_t)currentType;
+    snapshot.pieceX = (int8_t)currentX;
+    snapshot.pieceY = (int8_t)currentY;
+    snapshot.pieceRotation = (uint8_t)currentRotation;
+    snapshot.nextPiece = (nextType == Tetris::NONE) ? GAMESNAPSHOT_NO_PIECE : (uint8_t)nextType;
+    snapshot.heldPiece = (heldType == Tetris::NONE) ? GAMESNAPSHOT_NO_PIECE : (uint8_t)heldType;
+    snapshot.flags = (isGameOver ? GAMESNAPSHOT_FLAG_GAME_OVER : 0U) |
+                     (isPaused ? GAMESNAPSHOT_FLAG_PAUSED : 0U) |
+                     (hasHeld ? GAMESNAPSHOT_FLAG_HOLD_USED : 0U) |
+                     (gameScreenActive ? GAMESNAPSHOT_FLAG_ON_SCREEN : 0U);
+    snapshot.level = (uint8_t)level;
+    snapshot.score = (uint32_t)score;
+    snapshot.lines = (uint32_t)linesCount;
+
+    GameSnapshot_Publish(&snapshot);
+}
+#endif
+
 void Model::moveLeft()
 {
     if (isGameOver || isPaused) return;
     if (!isCollision(currentX - 1, currentY, currentRotation))
     {
         currentX--;
+        stateChanged = true;
     }
 }
 
@@ -139,6 +217,7 @@ void Model::moveRight()
     if (!isCollision(currentX + 1, currentY, currentRotation))
     {
         currentX++;
+        stateChanged = true;
     }
 }
 
@@ -149,6 +228,7 @@ void Model::rotate()
     if (!isCollision(currentX, currentY, nextRotation))
     {
         currentRotation = nextRotation;
+        stateChanged = true;
     }
 }
 
@@ -158,6 +238,7 @@ void Model::step()
     if (!isCollision(currentX, currentY + 1, currentRotation))
     {
         currentY++;
+        stateChanged = true;
     }
     else
     {
@@ -193,15 +274,13 @@ void Model::holdPiece()
     }
     
     hasHeld = true;
-    
-    if (modelListener != 0)
-    {
-        modelListener->modelStateChanged();
-    }
+    stateChanged = true;
 }
 
 void Model::lockPiece()
 {
+    TRACE_EVENT(TRACE_EVT_PIECE_LOCK, currentType);
+
     for (int row = 0; row < 4; row++)
     {
         for (int col = 0; col < 4; col++)
@@ -220,9 +299,10 @@ void Model::lockPiece()
 
     checkLines();
     spawnPiece();
+    stateChanged = true;
 }
 
-void Model::checkLines()
+RAM_FUNC void Model::checkLines()
 {
     int clearedInThisStep = 0;
 
@@ -261,6 +341,7 @@ void Model::checkLines()
 
     if (clearedInThisStep > 0)
     {
+        TRACE_EVENT(TRACE_EVT_LINE_CLEAR, clearedInThisStep);
         linesCount += clearedInThisStep;
         
         // Simple scoring: 100, 300, 500, 800
@@ -278,7 +359,7 @@ void Model::checkLines()
     }
 }
 
-bool Model::isCollision(int x, int y, int rotation) const
+RAM_FUNC bool Model::isCollision(int x, int y, int rotation) const
 {
     for (int row = 0; row < 4; row++)
     {
@@ -317,7 +398,7 @@ Tetris::TetrominoType Model::getRandomPiece()
 {
 #ifndef SIMULATOR
     uint32_t randomValue = 0;
-    if (HAL_RNG_GenerateRandomNumber(&hrng, &randomValue) == HAL_OK)
+    if (EntropyPool_Take(&randomValue))
     {
         return static_cast<Tetris::TetrominoType>(randomValue % Tetris::COUNT);
     }
@@ -339,4 +420,5 @@ void Model::togglePause()
 {
     if (isGameOver) return;
     isPaused = !isPaused;
+    stateChanged = true;
 }
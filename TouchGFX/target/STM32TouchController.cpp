@@ -22,6 +22,13 @@
 #include <STM32TouchController.hpp>
 #include "Components/stmpe811/stmpe811.h"
 
+extern "C" {
+#include "PowerManager.h"
+#include "TouchSampler.h"
+#include "TouchGesture.h"
+#include "TouchCalib.h"
+}
+
 #define TS_I2C_ADDRESS                      0x82
 
 static TS_DrvTypeDef*     TsDrv;
@@ -43,10 +50,18 @@ typedef enum
 } TS_StatusTypeDef;
 
 uint8_t BSP_TS_Init(uint16_t XSize, uint16_t YSize);
-void    BSP_TS_GetState(TS_StateTypeDef* TsState);
+void    BSP_TS_GetState(const TouchSampler_Sample* sample, TS_StateTypeDef* TsState);
 
 extern "C" uint8_t isRevD; /* Applicable only for STM32F429I DISCOVERY REVD and above */
 
+/* Pen up: ends the gesture and restarts the filter for the next pen down */
+static void releaseTouch(TS_StateTypeDef* state, uint32_t timeMs)
+{
+    TouchGesture_Release(timeMs);
+    TouchCalib_Reset();
+    state->TouchDetected = 0; // Wait for a fresh sample after the next pen down
+}
+
 void STM32TouchController::init()
 {
     /**
@@ -54,6 +69,9 @@ void STM32TouchController::init()
      *
      */
     BSP_TS_Init(240, 320);
+
+    /* Samples now arrive in bursts from the STMPE811 FIFO by I2C DMA */
+    TouchSampler_Init();
 }
 
 bool STM32TouchController::sampleTouch(int32_t& x, int32_t& y)
@@ -68,12 +86,75 @@ bool STM32TouchController::sampleTouch(int32_t& x, int32_t& y)
      * By default sampleTouch is called every tick, this can be adjusted by HAL::setTouchSampleRate(int8_t);
      *
      */
-    TS_StateTypeDef state;
-    BSP_TS_GetState(&state);
+    static TS_StateTypeDef state = { 0, 0, 0, 0 };
+    static bool releasePending = false;
+    static uint32_t releaseMs = 0;
+    TouchSampler_Sample sample;
+
+    /* During calibration the raw samples go to the 3-point procedure and
+       the GUI sees no touch at all */
+    if (TouchCalib_GetState() == TOUCHCAL_RUNNING)
+    {
+        static bool calibTouched = false;
+
+        while (TouchSampler_Read(&sample))
+        {
+            TouchCalib_CaptureSample(sample.x, sample.y);
+            calibTouched = true;
+        }
+        TouchSampler_Poll();
+
+        if (!TouchSampler_IsTouched() && calibTouched)
+        {
+            TouchCalib_CaptureRelease();
+            calibTouched = false;
+        }
+        state.TouchDetected = 0;
+        return false;
+    }
+
+    /* Touch keys are capped per call, so inputQueue (INPUT_QUEUE_LENGTH)
+       holds a whole tick's worth however many samples arrived */
+    TouchGesture_BeginTick();
+
+    /* Pen up seen on the previous call, deferred so its samples were
+       reported first; done before any new sample reaches the filter */
+    if (releasePending)
+    {
+        releaseTouch(&state, releaseMs);
+        releasePending = false;
+    }
+
+    /* Every sample goes through the filter (newest wins) and to the gesture
+       layer for its velocity estimate; no I2C traffic from the GUI task */
+    bool fresh = false;
+    while (TouchSampler_Read(&sample))
+    {
+        BSP_TS_GetState(&sample, &state);
+        TouchGesture_Sample(state.X, state.Y, sample.timeMs);
+        fresh = true;
+    }
+    TouchSampler_Poll();
+
+    if (!TouchSampler_IsTouched() && state.TouchDetected)
+    {
+        if (fresh)
+        {
+            /* A tap can start and end between two ticks (easily at the low
+               render rate): report its last position once, release next call */
+            releasePending = true;
+            releaseMs = HAL_GetTick();
+        }
+        else
+        {
+            releaseTouch(&state, HAL_GetTick());
+        }
+    }
     if (state.TouchDetected)
     {
         x = state.X;
         y = state.Y;
+        PowerManager_NotifyInput();
         return true;
     }
     return false;
@@ -110,105 +191,28 @@ uint8_t BSP_TS_Init(uint16_t XSize, uint16_t YSize)
         TsDrv->Start(TS_I2C_ADDRESS);
     }
 
+    /* Stored calibration, else the board's default mapping */
+    TouchCalib_Init(isRevD, TsXBoundary, TsYBoundary);
+
     return ret;
 }
 
 /**
   * @brief  Returns status and positions of the touch screen.
+  * @param  sample: Raw sample read from the FIFO by TouchSampler
   * @param  TsState: Pointer to touch screen current state structure
   */
-void BSP_TS_GetState(TS_StateTypeDef* TsState)
+void BSP_TS_GetState(const TouchSampler_Sample* sample, TS_StateTypeDef* TsState)
 {
-    static uint32_t _x = 0, _y = 0;
-    uint16_t xDiff, yDiff, x, y, xr, yr;
-
-    TsState->TouchDetected = TsDrv->DetectTouch(TS_I2C_ADDRESS);
-
-    if (TsState->TouchDetected)
-    {
-        TsDrv->GetXY(TS_I2C_ADDRESS, &x, &y);
-
-        if (isRevD)
-        {
-            //Ensures the coordinates are within the screen
-            if (y > 3700)
-            {
-                y = 3700;
-            }
-            else if (y < 180)
-            {
-                y = 180;
-            }
-
-            /* Y value first correction */
-            y -= 180;
-
-            /* Y value second correction */
-            y = 3520 - y;
-        }
-        else
-        {
-            /* Y value first correction */
-            y -= 360;
-        }
-
-        /* Y value second correction */
-        yr = y / 11;
-
-        /* Return y position value */
-        if (yr <= 0)
-        {
-            yr = 0;
-        }
-        else if (yr > TsYBoundary)
-        {
-            yr = TsYBoundary - 1;
-        }
-        else
-        {}
-        y = yr;
-
-        /* X value first correction */
-        if (x <= 3000)
-        {
-            x = 3870 - x;
-        }
-        else
-        {
-            x = 3800 - x;
-        }
-
-        /* X value second correction */
-        xr = x / 15;
-
-        /* Return X position value */
-        if (xr <= 0)
-        {
-            xr = 0;
-        }
-        else if (xr > TsXBoundary)
-        {
-            xr = TsXBoundary - 1;
-        }
-        else
-        {}
-
-        x = xr;
-        xDiff = x > _x ? (x - _x) : (_x - x);
-        yDiff = y > _y ? (y - _y) : (_y - y);
+    uint16_t x, y;
 
-        if (xDiff + yDiff > 5)
-        {
-            _x = x;
-            _y = y;
-        }
+    /* Median + IIR filter, calibrated transform and deadband (TouchCalib.h) */
+    TouchCalib_Process(sample->x, sample->y, &x, &y);
 
-        /* Update the X position */
-        TsState->X = _x;
-
-        /* Update the Y position */
-        TsState->Y = _y;
-    }
+    TsState->TouchDetected = 1;
+    TsState->X = x;
+    TsState->Y = y;
+    TsState->Z = sample->z;
 }
 
 /* USER CODE END STM32TouchController */
@@ -24,19 +24,110 @@
 
 #include "stm32f4xx.h"
 #include <touchgfx/hal/OSWrappers.hpp>
+#include <touchgfx/Bitmap.hpp>
+#include <images/BitmapDatabase.hpp>
 
 extern "C" {
-    void     LCD_IO_WriteReg(uint8_t Reg);
+#include "BootProfile.h"
+#include "LcdCommand.h"
+#include "PowerManager.h"
+#include "SdramBench.h"
+#include "Trace.h"
 }
 
 using namespace touchgfx;
 
+/*
+ * Frame buffer strategy
+ *
+ * 0: Double buffering (default). TouchGFX renders into the back buffer and
+ *    swaps at VSYNC.
+ * 1: Single buffering. TouchGFX redraws only the invalidated rectangles,
+ *    directly in the buffer LTDC scans out, and uses the LTDC line position
+ *    (getTFTCurrentLine) to stay behind the scan line. SDRAM traffic then
+ *    scales with the changed pixels, and the second 150 KB buffer is unused.
+ *
+ * No animation storage is reserved: the application only uses NoTransition
+ * screen changes, so the third full-size buffer was never read.
+ */
+#ifndef TOUCHGFX_SINGLE_FRAMEBUFFER
+#define TOUCHGFX_SINGLE_FRAMEBUFFER 0
+#endif
+
+/*
+ * Bitmap atlas
+ *
+ * 1: The block and panel bitmaps are copied once, back to back, into one
+ *    SDRAM region (the TouchGFX bitmap cache), so every cell and panel blit
+ *    reads from the same few KB instead of bitmaps scattered through flash.
+ *    TouchGFX bitmaps cannot have a row stride, so the atlas is a packed
+ *    strip of whole bitmaps rather than sub-rectangles of one image; the
+ *    widgets keep using the usual BITMAP_*_ID. The L8 palettes stay in flash.
+ */
+#ifndef TOUCHGFX_BITMAP_ATLAS
+#define TOUCHGFX_BITMAP_ATLAS 1
+#endif
+
+#if TOUCHGFX_BITMAP_ATLAS
 namespace
 {
-LOCATION_PRAGMA_NOLOAD("TouchGFX_Framebuffer")
-uint32_t animationStorage[(240 * 320 * 2 + 3) / 4] LOCATION_ATTRIBUTE_NOLOAD("TouchGFX_Framebuffer");
+const BitmapId atlasBitmaps[] = {
+    BITMAP_BLOCK_I_ID, BITMAP_BLOCK_J_ID, BITMAP_BLOCK_L_ID, BITMAP_BLOCK_O_ID,
+    BITMAP_BLOCK_S_ID, BITMAP_BLOCK_T_ID, BITMAP_BLOCK_Z_ID, BITMAP_BLOCK_GHOST_ID,
+    BITMAP_PANEL_HOLD_ID, BITMAP_PANEL_NEXT_ID, BITMAP_PANEL_SCORE_ID
+};
+
+// 8 L8 blocks + 3 ARGB8888 panels is ~40 KB, plus the cache bookkeeping
+LOCATION_PRAGMA_NOLOAD("BitmapAtlas")
+uint16_t bitmapAtlas[48 * 1024 / 2] LOCATION_ATTRIBUTE_NOLOAD("BitmapAtlas");
+
+// Cycles to blit one bitmap from wherever its pixels are now (DMA2D, polled)
+uint32_t blitCycles(BitmapId id)
+{
+    Bitmap bitmap(id);
+    const uint8_t* clut = (bitmap.getFormat() == Bitmap::L8) ? bitmap.getExtraData() : 0;
+
+    if (clut == 0 && bitmap.getFormat() != Bitmap::ARGB8888)
+    {
+        return 0;
+    }
+    // CLUT layout as in STM32DMA: uint16_t format, uint16_t size, entries
+    return SdramBench_BlitCycles(bitmap.getData(),
+                                 clut ? reinterpret_cast<const uint32_t*>(clut + 4) : 0,
+                                 clut ? reinterpret_cast<const uint16_t*>(clut)[1] : 0,
+                                 bitmap.getWidth(), bitmap.getHeight());
 }
 
+void buildBitmapAtlas()
+{
+    const uint8_t count = sizeof(atlasBitmaps) / sizeof(atlasBitmaps[0]);
+    uint32_t flashCycles = 0;
+    uint32_t sdramCycles = 0;
+    uint32_t bytes = 0;
+    uint8_t i;
+
+    Bitmap::setCache(bitmapAtlas, sizeof(bitmapAtlas));
+
+    for (i = 0; i < count; i++)
+    {
+        Bitmap bitmap(atlasBitmaps[i]);
+        uint32_t fromFlash = blitCycles(atlasBitmaps[i]);
+
+        if (!Bitmap::cache(atlasBitmaps[i]))
+        {
+            break; // Atlas full: the rest stay in flash
+        }
+        flashCycles += fromFlash;
+        sdramCycles += blitCycles(atlasBitmaps[i]);
+        bytes += bitmap.getWidth() * bitmap.getHeight() * ((bitmap.getFormat() == Bitmap::L8) ? 1U : 4U);
+    }
+
+    // Reported with the boot timeline ({"atlas":...})
+    SdramBench_SetAtlas(i, bytes, flashCycles, sdramCycles);
+}
+} // namespace
+#endif
+
 void TouchGFXHAL::initialize()
 {
     // Calling parent implementation of initialize().
@@ -47,27 +138,92 @@ void TouchGFXHAL::initialize()
 
     TouchGFXGeneratedHAL::initialize();
 
-    // Add animation storage
-    setAnimationStorage((void*)animationStorage);
+#if TOUCHGFX_BITMAP_ATLAS
+    // Runs from MX_TouchGFX_Init: DMA2D is idle, SDRAM is up
+    buildBitmapAtlas();
+#endif
+
+#if TOUCHGFX_SINGLE_FRAMEBUFFER
+    // Keep only the first generated buffer, render in step with the LTDC scan line
+    setFrameBufferStartAddresses((void*)frameBuffer0, (void*)0, (void*)0);
+    setFrameRefreshStrategy(REFRESH_STRATEGY_OPTIM_SINGLE_BUFFER_TFT_CTRL);
+#endif
 }
 
 void TouchGFXHAL::taskEntry()
 {
+    BootProfile_Mark(BOOT_STAGE_GUI);
+
     enableLCDControllerInterrupt();
     enableInterrupts();
 
     OSWrappers::waitForVSync();
     backPorchExited();
 
-    LCD_IO_WriteReg(0x29);
+    LcdCommand_Write(0x29, 0, 0); // Display on, queued behind the panel init
+
+    uint8_t vsyncCount = 0;
+    bool firstFrameShown = false;
 
     for (;;)
     {
         OSWrappers::waitForVSync();
+
+        // The first frame was swapped in at this VSYNC; it is on screen
+        // once Display On has gone out behind the panel init
+        if (!firstFrameShown && !LcdCommand_IsBusy())
+        {
+            BootProfile_Mark(BOOT_STAGE_FIRST_FRAME);
+            firstFrameShown = true;
+        }
+
+        // Low render rate: only every Nth VSYNC runs a TouchGFX tick, the
+        // GUI task stays blocked (and the core asleep) for the others
+        if (++vsyncCount < PowerManager_GetFrameInterval())
+        {
+            PowerManager_FrameThrottled();
+            continue;
+        }
+        vsyncCount = 0;
         backPorchExited();
     }
 }
 
+/**
+ * Called by the framework before rendering a frame.
+ *
+ * @return true if rendering can begin, false otherwise.
+ */
+bool TouchGFXHAL::beginFrame()
+{
+    TRACE_EVENT(TRACE_EVT_RENDER_START, 0);
+    return TouchGFXGeneratedHAL::beginFrame();
+}
+
+/**
+ * Called by the framework after rendering a frame.
+ */
+void TouchGFXHAL::endFrame()
+{
+    TouchGFXGeneratedHAL::endFrame();
+    TRACE_EVENT(TRACE_EVT_RENDER_END, 0);
+}
+
+/**
+ * Gets the line currently being scanned out by LTDC. Only used by the
+ * single buffer refresh strategy.
+ *
+ * @return The active-area line (0 while still in the vertical back porch).
+ */
+uint16_t TouchGFXHAL::getTFTCurrentLine()
+{
+    // CPSR.CYPOS counts lines from the start of VSYNC
+    uint16_t curr = (uint16_t)(LTDC->CPSR & 0xFFFF);
+    uint16_t backPorchY = (uint16_t)(LTDC->BPCR & 0x7FF) + 1;
+
+    return (curr < backPorchY) ? 0 : curr - backPorchY;
+}
+
 /**
  * Gets the frame buffer address used by the TFT controller.
  *
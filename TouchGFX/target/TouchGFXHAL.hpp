@@ -122,6 +122,38 @@ public:
      */
     virtual void flushFrameBuffer(const touchgfx::Rect& rect);
 
+    /**
+     * @fn virtual bool TouchGFXHAL::beginFrame();
+     *
+     * @brief Called when a rendering pass starts.
+     *
+     *        Called when a rendering pass starts. Records a render start trace event.
+     *
+     * @return true if rendering can begin, false otherwise.
+     */
+    virtual bool beginFrame();
+
+    /**
+     * @fn virtual void TouchGFXHAL::endFrame();
+     *
+     * @brief Called when a rendering pass ends.
+     *
+     *        Called when a rendering pass ends. Records a render end trace event.
+     */
+    virtual void endFrame();
+
+    /**
+     * @fn virtual uint16_t TouchGFXHAL::getTFTCurrentLine();
+     *
+     * @brief Gets the line currently being scanned out by LTDC.
+     *
+     *        Gets the line currently being scanned out by LTDC. Required by
+     *        REFRESH_STRATEGY_OPTIM_SINGLE_BUFFER_TFT_CTRL (TOUCHGFX_SINGLE_FRAMEBUFFER).
+     *
+     * @return The current line in the active area.
+     */
+    virtual uint16_t getTFTCurrentLine();
+
 protected:
     /**
      * @fn virtual uint16_t* TouchGFXHAL::getTFTFrameBuffer() const;
@@ -60,6 +60,17 @@ defined in linker script */
 .word  _sbss
 /* end address for the .bss section. defined in linker script */
 .word  _ebss
+/* start address for the initialization values of the .ccmram section.
+defined in linker script */
+.word  _siccmram
+/* start address for the .ccmram section. defined in linker script */
+.word  _sccmram
+/* end address for the .ccmram section. defined in linker script */
+.word  _eccmram
+/* start address for the .ccmbss section. defined in linker script */
+.word  _sccmbss
+/* end address for the .ccmbss section. defined in linker script */
+.word  _eccmbss
 /* stack used for SystemInit_ExtMemCtl; always internal RAM used */
 
 /**
@@ -105,6 +116,31 @@ LoopFillZerobss:
   cmp  r2, r3
   bcc  FillZerobss
 
+/* Copy the CCM data initializers from flash to CCM RAM */
+  ldr  r0, =_sccmram
+  ldr  r1, =_eccmram
+  ldr  r2, =_siccmram
+  b  LoopCopyCcmInit
+
+CopyCcmInit:
+  ldr  r3, [r2], #4
+  str  r3, [r0], #4
+
+LoopCopyCcmInit:
+  cmp  r0, r1
+  bcc  CopyCcmInit
+  ldr  r2, =_sccmbss
+  b  LoopFillZeroCcmbss
+/* Zero fill the CCM bss segment. */
+FillZeroCcmbss:
+  movs  r3, #0
+  str  r3, [r2], #4
+
+LoopFillZeroCcmbss:
+  ldr  r3, =_eccmbss
+  cmp  r2, r3
+  bcc  FillZeroCcmbss
+
 /* Call the clock system intitialization function.*/
   bl  SystemInit   
 /* Call static constructors */
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""Summarize a GNU ld map file: region usage and what landed in CCM RAM.
+
+The gcc/Makefile build writes the map next to the ELF and runs this after
+linking; for STM32CubeIDE builds point it at Debug/<project>.map:
+
+    python3 tools/memory_map.py TouchGFX/build/bin/application.map
+    python3 tools/memory_map.py app.map --top 20     more of the largest RAM users
+
+Input sections in CCM are listed one by one (CCM_BSS/CCM_DATA in
+Core/Inc/CcmRam.h); with -fdata-sections the RAM list names each variable.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+REGION = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+SECTION = re.compile(r"^(\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address 0x([0-9a-fA-F]+))?\s*$")
+INPUT = re.compile(r"^ (\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+CCM_SECTIONS = (".ccmram", ".ccmbss")
+RAM_SECTIONS = (".data", ".bss", ".tbss", ".tdata", "COMMON")
+
+
+def parse(path):
+    """Returns (regions, output sections, input sections) from a map file."""
+    regions = []
+    outputs = []    # (name, vma, size, lma)
+    inputs = []     # (output name, input name, vma, size, object)
+
+    with open(path) as f:
+        lines = f.read().splitlines()
+
+    try:
+        start = lines.index("Memory Configuration")
+        body = lines.index("Linker script and memory map")
+    except ValueError:
+        sys.exit("%s: not a GNU ld map file" % path)
+
+    for line in lines[start + 1:body]:
+        m = REGION.match(line)
+        if m and m.group(1) not in ("Name", "*default*"):
+            regions.append((m.group(1), int(m.group(2), 16), int(m.group(3), 16)))
+
+    current = None
+    pending = None   # Long names are printed alone, with the numbers on the next line
+    pending_input = None
+    for line in lines[body + 1:]:
+        if not line:
+            continue
+        if not line[0].isspace():
+            m = SECTION.match(line)
+            if m and m.group(1):
+                current = m.group(1)
+                lma = int(m.group(4), 16) if m.group(4) else None
+                outputs.append((current, int(m.group(2), 16), int(m.group(3), 16), lma))
+                pending = None
+            elif " " not in line.strip():
+                current = pending = line.strip()
+            pending_input = None
+            continue
+
+        if pending is not None:
+            m = SECTION.match(line)
+            if m:
+                lma = int(m.group(4), 16) if m.group(4) else None
+                outputs.append((pending, int(m.group(2), 16), int(m.group(3), 16), lma))
+            pending = None
+            continue
+
+        m = INPUT.match(line)
+        if m and current is not None:
+            name = m.group(1) or pending_input
+            if name and not name.startswith("*"):
+                inputs.append((current, name, int(m.group(2), 16), int(m.group(3), 16), m.group(4)))
+            pending_input = None
+        elif line.startswith(" ") and not line.startswith("  ") and len(line.split()) == 1:
+            pending_input = line.strip()
+
+    return regions, outputs, inputs
+
+
+def region_of(regions, address):
+    for name, origin, length in regions:
+        if origin <= address < origin + length:
+            return name
+    return None
+
+
+def short(obj):
+    obj = obj.replace("\\", "/")
+    if "(" in obj:  # archive(member.o)
+        return obj[obj.index("(") + 1:obj.rindex(")")]
+    return os.path.basename(obj)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("map", help="map file written by the linker (-Wl,-Map=...)")
+    parser.add_argument("--top", type=int, default=10, help="largest RAM input sections to list")
+    args = parser.parse_args()
+
+    regions, outputs, inputs = parse(args.map)
+
+    used = dict((name, 0) for name, _, _ in regions)
+    for name, vma, size, lma in outputs:
+        region = region_of(regions, vma)
+        if region is not None:
+            used[region] += size
+        load = region_of(regions, lma) if lma is not None else None
+        if load is not None and load != region:
+            used[load] += size
+
+    print("%-10s %10s %10s %7s" % ("Region", "Used", "Size", "Use"))
+    for name, _, length in regions:
+        print("%-10s %10d %10d %6.1f%%" % (name, used[name], length, 100.0 * used[name] / length))
+
+    ccm = [i for i in inputs if i[0] in CCM_SECTIONS and i[3] > 0]
+    print("\nCCMRAM (%d bytes)" % sum(i[3] for i in ccm))
+    for output, name, vma, size, obj in sorted(ccm, key=lambda i: -i[3]):
+        print("  0x%08X %8d  %-9s %s" % (vma, size, output, short(obj)))
+
+    ram = [i for i in inputs if i[0] in RAM_SECTIONS and i[3] > 0
+           and region_of(regions, i[2]) == "RAM"]
+    print("\nLargest RAM users")
+    for output, name, vma, size, obj in sorted(ram, key=lambda i: -i[3])[:args.top]:
+        print("  0x%08X %8d  %-28s %s" % (vma, size, name, short(obj)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Convert tools/music/*.song into the tracker tables used by MusicTracker.c.
+
+Song source format (one file per song, '#' starts a comment):
+
+    song     song_game        C symbol of the TrackerSong
+    tick     200              milliseconds per tick
+    channel  lead             starts a channel (at most 2 per song)
+      E5:2 B4:1 C5:1 R:2      one line = one pattern; NOTE:TICKS, R = rest
+    loop                      looping playback restarts at the next pattern
+
+Identical patterns are stored once per song. Rows longer than 64 ticks are
+split; the mixer keeps the oscillator phase, so the split is inaudible.
+
+Usage: python3 tools/music_convert.py   (run from the repository root)
+"""
+
+import glob
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE_GLOB = os.path.join(ROOT, "tools", "music", "*.song")
+OUT_C = os.path.join(ROOT, "Core", "Src", "MusicData.c")
+OUT_H = os.path.join(ROOT, "Core", "Inc", "MusicData.h")
+
+MAX_CHANNELS = 2
+MAX_LENGTH = 64
+ORDER_LOOP = 0xFE
+ORDER_END = 0xFF
+ROW_LENGTH = 0x80
+ROW_END = 0xFF
+
+SEMITONES = {"C": 0, "D": 2, "E": 4, "F": 5, "G": 7, "A": 9, "B": 11}
+NOTE_RE = re.compile(r"^([A-G])([#b]?)([1-8])$")
+
+
+def note_index(name, where):
+    """C1 = 1 ... B8 = 96, rest = 0."""
+    if name == "R":
+        return 0
+    m = NOTE_RE.match(name)
+    if not m:
+        sys.exit("%s: bad note '%s'" % (where, name))
+    semitone = SEMITONES[m.group(1)] + {"#": 1, "b": -1, "": 0}[m.group(2)]
+    index = (int(m.group(3)) - 1) * 12 + semitone + 1
+    if not 1 <= index <= 96:
+        sys.exit("%s: note '%s' out of range" % (where, name))
+    return index
+
+
+def encode_pattern(tokens, where):
+    """Returns (pattern bytes, number of notes in the old MusicNote form)."""
+    data = []
+    length = None
+    for token in tokens:
+        try:
+            name, ticks = token.split(":")
+            ticks = int(ticks)
+        except ValueError:
+            sys.exit("%s: bad row '%s'" % (where, token))
+        if ticks < 1:
+            sys.exit("%s: row '%s' has no length" % (where, token))
+        note = note_index(name, where)
+        while ticks > 0:
+            step = min(ticks, MAX_LENGTH)
+            if step != length:
+                data.append(ROW_LENGTH | (step - 1))
+                length = step
+            data.append(note)
+            ticks -= step
+    data.append(ROW_END)
+    return data, len(tokens)
+
+
+def parse_song(path):
+    song = {"symbol": None, "tick": None, "channels": [], "source": os.path.basename(path)}
+    channel = None
+    with open(path) as f:
+        for lineno, raw in enumerate(f, 1):
+            line = raw.split("#", 1)[0].strip()
+            if not line:
+                continue
+            where = "%s:%d" % (path, lineno)
+            words = line.split()
+            if words[0] == "song":
+                song["symbol"] = words[1]
+            elif words[0] == "tick":
+                song["tick"] = int(words[1])
+            elif words[0] == "channel":
+                channel = {"name": words[1], "patterns": [], "loop": None}
+                song["channels"].append(channel)
+            elif words[0] == "loop":
+                if channel is None:
+                    sys.exit("%s: 'loop' outside a channel" % where)
+                channel["loop"] = len(channel["patterns"])
+            else:
+                if channel is None:
+                    sys.exit("%s: rows outside a channel" % where)
+                channel["patterns"].append(encode_pattern(words, where))
+    if not song["symbol"] or not song["tick"]:
+        sys.exit("%s: missing 'song' or 'tick'" % path)
+    if not 1 <= len(song["channels"]) <= MAX_CHANNELS:
+        sys.exit("%s: songs need 1-%d channels" % (path, MAX_CHANNELS))
+    return song
+
+
+def emit_song(song, out):
+    symbol = song["symbol"]
+    pool = []
+    orders = []
+    notes = 0
+    for channel in song["channels"]:
+        order = []
+        for i, (data, count) in enumerate(channel["patterns"]):
+            if i == channel["loop"]:
+                order.append(ORDER_LOOP)
+            if data not in pool:
+                pool.append(data)
+            order.append(pool.index(data))
+            notes += count
+        order.append(ORDER_END)
+        orders.append(order)
+        notes += 1  # {0,0} terminator of the old format
+
+    if len(pool) >= ORDER_LOOP:
+        sys.exit("%s: too many patterns" % song["source"])
+
+    out.append("/* %s */" % song["source"])
+    for i, data in enumerate(pool):
+        out.append("static const uint8_t %s_p%d[] = { %s };"
+                   % (symbol, i, ", ".join("0x%02X" % b for b in data)))
+    out.append("static const uint8_t* const %s_patterns[] = { %s };"
+               % (symbol, ", ".join("%s_p%d" % (symbol, i) for i in range(len(pool)))))
+    for channel, order in zip(song["channels"], orders):
+        out.append("static const uint8_t %s_%s[] = { %s };"
+                   % (symbol, channel["name"], ", ".join("0x%02X" % b for b in order)))
+    out.append("const TrackerSong %s = {" % symbol)
+    out.append("    %d, %d, %s_patterns," % (song["tick"], len(orders), symbol))
+    out.append("    { %s }" % ", ".join("%s_%s" % (symbol, c["name"]) for c in song["channels"]))
+    out.append("};")
+    out.append("")
+
+    size = sum(len(d) for d in pool) + sum(len(o) for o in orders) + 4 * len(pool)
+    return size, notes * 4
+
+
+def main():
+    sources = sorted(glob.glob(SOURCE_GLOB))
+    if not sources:
+        sys.exit("no songs found in %s" % os.path.dirname(SOURCE_GLOB))
+
+    songs = [parse_song(p) for p in sources]
+
+    body = []
+    total = legacy = 0
+    for song in songs:
+        size, old = emit_song(song, body)
+        total += size
+        legacy += old
+        print("%-16s %4d bytes (MusicNote arrays: %d)" % (song["symbol"], size, old))
+    print("%-16s %4d bytes (MusicNote arrays: %d)" % ("total", total, legacy))
+
+    banner = "Generated by tools/music_convert.py from tools/music - do not edit"
+
+    with open(OUT_C, "w") as f:
+        f.write("/*\n * MusicData.c\n *\n * %s\n */\n\n" % banner)
+        f.write('#include "MusicData.h"\n\n')
+        f.write("\n".join(body))
+
+    with open(OUT_H, "w") as f:
+        f.write("/*\n * MusicData.h\n *\n * %s\n */\n\n" % banner)
+        f.write("#ifndef INC_MUSICDATA_H_\n#define INC_MUSICDATA_H_\n\n")
+        f.write('#ifdef __cplusplus\nextern "C" {\n#endif\n\n')
+        f.write('#include "MusicTracker.h"\n\n')
+        for song in songs:
+            f.write("extern const TrackerSong %s;\n" % song["symbol"])
+        f.write('\n#ifdef __cplusplus\n}\n#endif\n\n#endif /* INC_MUSICDATA_H_ */\n')
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+"""Decode a trace recorder dump (Core/Src/Trace.c) into a timeline.
+
+Take the dump with the debugger while the target is halted, e.g. in GDB:
+
+    dump binary memory trace.bin &traceBuffer (char*)&traceBuffer + sizeof(traceBuffer)
+
+Then:
+
+    python3 tools/trace_decode.py trace.bin                   text timeline
+    python3 tools/trace_decode.py trace.bin --last 2000       only the newest records
+    python3 tools/trace_decode.py trace.bin --chrome out.json open in chrome://tracing or Perfetto
+
+Timestamps come from the cycle counter, which stops while the core sleeps;
+TRACE_EVT_SLEEP records carry the slept time and are added back in.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x45435254
+VERSION = 1
+MAX_TASKS = 16
+MAX_QUEUES = 8
+NAME_LEN = 16
+HEADER = struct.Struct("<5I")
+RECORD = struct.Struct("<IHHI")
+CONTEXT_ISR = 0x8000
+
+# Keep in sync with Core/Inc/Trace.h
+TASK_SWITCH = 0x01
+QUEUE_SEND = 0x02
+QUEUE_RECEIVE = 0x03
+QUEUE_BLOCK = 0x04
+ISR_ENTER = 0x05
+ISR_EXIT = 0x06
+SLEEP = 0x07
+STACK_OVERFLOW = 0x08
+MALLOC_FAILED = 0x09
+GAME_TICK = 0x20
+PIECE_LOCK = 0x21
+LINE_CLEAR = 0x22
+RENDER_START = 0x23
+RENDER_END = 0x24
+
+EVENT_NAMES = {
+    TASK_SWITCH: "task_switch",
+    QUEUE_SEND: "queue_send",
+    QUEUE_RECEIVE: "queue_receive",
+    QUEUE_BLOCK: "queue_block",
+    ISR_ENTER: "isr_enter",
+    ISR_EXIT: "isr_exit",
+    SLEEP: "sleep",
+    STACK_OVERFLOW: "stack_overflow",
+    MALLOC_FAILED: "malloc_failed",
+    GAME_TICK: "game_tick",
+    PIECE_LOCK: "piece_lock",
+    LINE_CLEAR: "line_clear",
+    RENDER_START: "render_start",
+    RENDER_END: "render_end",
+}
+
+# Exception number (IRQn + 16) -> handler, for the interrupts in stm32f4xx_it.c
+EXCEPTION_NAMES = {
+    24: "EXTI2",
+    25: "EXTI3",
+    29: "DMA1_Stream2",
+    53: "USART1",
+    56: "EXTI15_10",
+    73: "DMA2_Stream1",
+    76: "DMA2_Stream4",
+    88: "I2C3_EV",
+    89: "I2C3_ER",
+    96: "HASH_RNG",
+    104: "LTDC",
+    106: "DMA2D",
+}
+
+
+def read_names(data, offset, count):
+    names = []
+    for i in range(count):
+        raw = data[offset + i * NAME_LEN:offset + (i + 1) * NAME_LEN]
+        names.append(raw.split(b"\0", 1)[0].decode("ascii", "replace"))
+    return names, offset + count * NAME_LEN
+
+
+def load(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < HEADER.size:
+        sys.exit("%s: too short for a trace header" % path)
+
+    magic, version, cpu_hz, record_count, head = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        sys.exit("%s: bad magic 0x%08X (is this a dump of traceBuffer?)" % (path, magic))
+    if version != VERSION:
+        sys.exit("%s: trace version %d, decoder knows %d" % (path, version, VERSION))
+
+    tasks, offset = read_names(data, HEADER.size, MAX_TASKS)
+    queues, offset = read_names(data, offset, MAX_QUEUES)
+
+    available = (len(data) - offset) // RECORD.size
+    if available < record_count:
+        print("warning: dump holds %d of %d records" % (available, record_count), file=sys.stderr)
+        record_count = available
+
+    first = max(0, head - record_count)
+    records = []
+    for n in range(first, head):
+        records.append(RECORD.unpack_from(data, offset + (n % record_count) * RECORD.size))
+    return cpu_hz, tasks, queues, records
+
+
+def timeline(cpu_hz, records):
+    """Yields (time_us, event, context, arg), time relative to the oldest record."""
+    time_us = 0.0
+    previous = None
+    for cycles, event, context, arg in records:
+        if previous is not None:
+            time_us += ((cycles - previous) & 0xFFFFFFFF) * 1e6 / cpu_hz
+        previous = cycles
+        if event == SLEEP:
+            time_us += arg  # Counter was stopped during WFI
+        yield time_us, event, context, arg
+
+
+def context_name(context, tasks):
+    if context & CONTEXT_ISR:
+        number = context & ~CONTEXT_ISR
+        return "ISR " + EXCEPTION_NAMES.get(number, "#%d" % number)
+    if context < len(tasks) and tasks[context]:
+        return tasks[context]
+    return "task %d" % context
+
+
+def detail(event, arg, tasks, queues):
+    if event == TASK_SWITCH:
+        return context_name(arg, tasks)
+    if event in (QUEUE_SEND, QUEUE_RECEIVE, QUEUE_BLOCK):
+        return queues[arg] if arg < len(queues) and queues[arg] else "queue %d" % arg
+    if event in (ISR_ENTER, ISR_EXIT):
+        return EXCEPTION_NAMES.get(arg, "#%d" % arg)
+    if event == SLEEP:
+        return "%d us" % arg
+    return str(arg)
+
+
+def print_text(cpu_hz, tasks, queues, records):
+    print("%d records, CPU %d Hz" % (len(records), cpu_hz))
+    for time_us, event, context, arg in timeline(cpu_hz, records):
+        print("%14.3f  %-20s %-14s %s" % (
+            time_us / 1000.0, context_name(context, tasks),
+            EVENT_NAMES.get(event, "event 0x%02X" % event), detail(event, arg, tasks, queues)))
+
+
+def write_chrome(path, cpu_hz, tasks, queues, records):
+    """Chrome trace event format: one row per task and per interrupt."""
+    events = []
+    running = None      # (task number, start)
+    isr_start = {}
+    render_start = None
+
+    for time_us, event, context, arg in timeline(cpu_hz, records):
+        if event == TASK_SWITCH:
+            if running is not None:
+                events.append({"name": context_name(running[0], tasks), "ph": "X", "pid": 0,
+                               "tid": running[0], "ts": running[1], "dur": time_us - running[1]})
+            running = (arg, time_us)
+        elif event == ISR_ENTER:
+            isr_start[arg] = time_us
+        elif event == ISR_EXIT and arg in isr_start:
+            start = isr_start.pop(arg)
+            events.append({"name": EXCEPTION_NAMES.get(arg, "#%d" % arg), "ph": "X", "pid": 1,
+                           "tid": arg, "ts": start, "dur": time_us - start})
+        elif event == RENDER_START:
+            render_start = time_us
+        elif event == RENDER_END and render_start is not None:
+            events.append({"name": "render", "ph": "X", "pid": 2, "tid": 0,
+                           "ts": render_start, "dur": time_us - render_start})
+            render_start = None
+        else:
+            tid = context & ~CONTEXT_ISR if context & CONTEXT_ISR else context
+            events.append({"name": EVENT_NAMES.get(event, "event 0x%02X" % event), "ph": "i", "s": "t",
+                           "pid": 1 if context & CONTEXT_ISR else 0, "tid": tid, "ts": time_us,
+                           "args": {"detail": detail(event, arg, tasks, queues)}})
+
+    meta = [{"name": "process_name", "ph": "M", "pid": 0, "args": {"name": "Tasks"}},
+            {"name": "process_name", "ph": "M", "pid": 1, "args": {"name": "Interrupts"}},
+            {"name": "process_name", "ph": "M", "pid": 2, "args": {"name": "TouchGFX"}}]
+    for number, name in enumerate(tasks):
+        if name:
+            meta.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": number, "args": {"name": name}})
+    for number, name in EXCEPTION_NAMES.items():
+        meta.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": number, "args": {"name": name}})
+
+    with open(path, "w") as f:
+        json.dump({"traceEvents": meta + events, "displayTimeUnit": "ms"}, f)
+    print("wrote %d events to %s" % (len(events), path))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("dump", help="binary dump of traceBuffer")
+    parser.add_argument("--last", type=int, default=0, help="only decode the newest N records")
+    parser.add_argument("--chrome", metavar="JSON", help="write a Chrome trace instead of text")
+    args = parser.parse_args()
+
+    cpu_hz, tasks, queues, records = load(args.dump)
+    if args.last > 0:
+        records = records[-args.last:]
+    if not records:
+        sys.exit("trace is empty")
+
+    if args.chrome:
+        write_chrome(args.chrome, cpu_hz, tasks, queues, records)
+    else:
+        print_text(cpu_hz, tasks, queues, records)
+
+
+if __name__ == "__main__":
+    main()